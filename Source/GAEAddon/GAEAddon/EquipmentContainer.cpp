@@ -6,8 +6,10 @@
 #include "EquipmentInstance.h"
 #include "EquipmentManagerComponent.h"
 #include "EquipmentSlotChangeMessage.h"
+#include "Pool/EquipmentInstancePoolSubsystem.h"
 #include "GameplayTag/GAEATags_Message.h"
 #include "GAEAddonLogs.h"
+#include "GAEAddonStats.h"
 
 #include "Message/GameplayMessageSubsystem.h"
 
@@ -39,55 +41,129 @@ bool FEquipmentEntry::IsValid() const
 
 void FEquipmentContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("PreReplicatedRemove", STAT_GAEA_PreReplicatedRemove);
+
  	for (const auto& Index : RemovedIndices)
  	{
-		const auto& Entry{ Entries[Index] };
-		if (Entry.IsValid())
+		auto& Entry{ Entries[Index] };
+		if (Entry.bLocallyEquiped && Entry.IsValid())
 		{
 			const auto& Instance{ Entry.Instance };
 			const auto& Data{ Entry.Data };
 
-			if (Entry.Activated == true)
+			if (Entry.bLocallyActivated)
 			{
-				Instance->OnDeactivated(OwnerComponent, Data);
+				DeactivateInstance(Entry);
 			}
 
 			Instance->OnUnequiped(OwnerComponent, Data);
 
+			Entry.bLocallyEquiped = false;
+
 			BroadcastSlotChangeMessage(Entry.SlotTag);
 		}
  	}
+
+	// Entries are removed after this call, so the cache is rebuilt on next use
+
+	bIndexCacheDirty = true;
 }
 
 void FEquipmentContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("PostReplicatedAdd", STAT_GAEA_PostReplicatedAdd);
+
+	// The activation state is decided by the separately replicated active slot
+
+	if (IsActiveSlotReplicatedSeparately())
+	{
+		for (const auto& Index : AddedIndices)
+		{
+			auto& Entry{ Entries[Index] };
+			Entry.Activated = (Entry.SlotTag == OwnerComponent->ReplicatedActiveSlotTag);
+		}
+	}
+
+	RebuildIndexCache();
+
 	for (const auto& Index : AddedIndices)
 	{
-		const auto& Entry{ Entries[Index] };
+		auto& Entry{ Entries[Index] };
 		if (Entry.IsValid())
 		{
-			const auto& Instance{ Entry.Instance };
-			const auto& Data{ Entry.Data };
+			EquipReplicatedEntry(Entry);
+		}
+	}
+}
 
-			Instance->OnEquiped(OwnerComponent, Data);
+void FEquipmentContainer::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	GAEA_SCOPE_CYCLE_COUNTER("PostReplicatedChange", STAT_GAEA_PostReplicatedChange);
 
-			BroadcastSlotChangeMessage(Entry.SlotTag, Data, Instance);
+	if (bIndexCacheDirty)
+	{
+		RebuildIndexCache();
+	}
 
-			if (Entry.Activated == true)
-			{
-				Instance->OnActivated(OwnerComponent, Data);
+	// Entries are not changed by activation, so keep the local activation state
 
-				BroadcastActiveSlotChangeMessage(Entry.SlotTag, Data, Instance);
+	if (IsActiveSlotReplicatedSeparately())
+	{
+		for (const auto& Index : ChangedIndices)
+		{
+			auto& Entry{ Entries[Index] };
+			Entry.Activated = (Entry.SlotTag == OwnerComponent->ReplicatedActiveSlotTag);
+
+			// Instance may be received after the entry depending on the replication policy
+
+			if (!Entry.bLocallyEquiped && Entry.IsValid())
+			{
+				EquipReplicatedEntry(Entry);
 			}
 		}
+
+		return;
 	}
-}
 
-void FEquipmentContainer::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
-{
 	for (const auto& Index : ChangedIndices)
 	{
-		const auto& Entry{ Entries[Index] };
+		auto& Entry{ Entries[Index] };
+
+		// While predicting, the local activation state is kept until the prediction is resolved
+
+		if (IsActiveSlotPredicted())
+		{
+			if (!Entry.bLocallyEquiped && Entry.IsValid())
+			{
+				EquipReplicatedEntry(Entry);
+			}
+
+			continue;
+		}
+
+		// Keep active entry index up to date
+
+		if (Entry.Activated == true)
+		{
+			ActiveEntryIndex = Index;
+		}
+		else if (ActiveEntryIndex == Index)
+		{
+			ActiveEntryIndex = INDEX_NONE;
+		}
+
+		// Instance may be received after the entry depending on the replication policy
+
+		if (!Entry.bLocallyEquiped)
+		{
+			if (Entry.IsValid())
+			{
+				EquipReplicatedEntry(Entry);
+			}
+
+			continue;
+		}
+
 		if (Entry.IsValid())
 		{
 			const auto& Instance{ Entry.Instance };
@@ -95,21 +171,52 @@ void FEquipmentContainer::PostReplicatedChange(const TArrayView<int32> ChangedIn
 
 			if (Entry.Activated == true)
 			{
-				Instance->OnActivated(OwnerComponent, Data);
+				if (!Entry.bLocallyActivated)
+				{
+					ActivateInstance(Entry);
 
-				BroadcastActiveSlotChangeMessage(Entry.SlotTag, Data, Instance);
+					BroadcastActiveSlotChangeMessage(Entry.SlotTag, Data, Instance);
+				}
 			}
 			else
 			{
-				Instance->OnDeactivated(OwnerComponent, Data);
+				DeactivateInstance(Entry);
 			}
 		}
 	}
+
+	if (IsActiveSlotPredicted())
+	{
+		OwnerComponent->ReconcileActiveSlotPrediction();
+	}
+}
+
+void FEquipmentContainer::EquipReplicatedEntry(FEquipmentEntry& Entry)
+{
+	const auto& Instance{ Entry.Instance };
+	const auto& Data{ Entry.Data };
+
+	Instance->OnEquiped(OwnerComponent, Data);
+
+	Entry.bLocallyEquiped = true;
+
+	BroadcastSlotChangeMessage(Entry.SlotTag, Data, Instance);
+
+	OwnerComponent->RequestEquipmentPreload(Entry.SlotTag, Data);
+
+	if (ShouldActivateLocally(Entry))
+	{
+		ActivateInstance(Entry);
+
+		BroadcastActiveSlotChangeMessage(Entry.SlotTag, Data, Instance);
+	}
 }
 
 
 UEquipmentInstance* FEquipmentContainer::AddEntry(const UEquipmentData* EquipmentData, FGameplayTag SlotTag)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("AddEntry", STAT_GAEA_AddEntry);
+
 	if (!EquipmentData)
 	{
 		UE_LOG(LogGAEA, Warning, TEXT("Invalid EquipmentData was attempted to be added."));
@@ -119,12 +226,18 @@ UEquipmentInstance* FEquipmentContainer::AddEntry(const UEquipmentData* Equipmen
 
 	// Is it trying to add to the allowed slots?
 
-	if (!EquipmentData->AllowedSlotTags.IsEmpty())
+	if (!EquipmentData->IsSlotAllowed(SlotTag))
 	{
-		if (!EquipmentData->AllowedSlotTags.HasTag(SlotTag))
-		{
-			return nullptr;
-		}
+		return nullptr;
+	}
+	
+	// Is the slot already in use?
+
+	if (FindEntryIndex(SlotTag) != INDEX_NONE)
+	{
+		UE_LOG(LogGAEA, Warning, TEXT("EquipmentData(%s) was attempted to be added to slot(%s) already in use."), *GetNameSafe(EquipmentData), *SlotTag.GetTagName().ToString());
+
+		return nullptr;
 	}
 	
 	// Create instance
@@ -135,56 +248,85 @@ UEquipmentInstance* FEquipmentContainer::AddEntry(const UEquipmentData* Equipmen
 		InstanceType = EquipmentData->InstanceType;
 	}
 	
-	auto& NewEntry{ Entries.AddDefaulted_GetRef() };
+	const auto NewIndex{ Entries.AddDefaulted() };
+	SlotIndexMap.Add(SlotTag, NewIndex);
+
+	auto& NewEntry{ Entries[NewIndex] };
 	NewEntry.SlotTag = SlotTag;
 	NewEntry.Data = EquipmentData;
-	NewEntry.Instance = NewObject<UEquipmentInstance>(OwnerComponent->GetOwner(), InstanceType);
+	NewEntry.Instance = UEquipmentInstancePoolSubsystem::AcquireInstanceFor(InstanceType, OwnerComponent->GetOwner());
 	NewEntry.Instance->OnEquiped(OwnerComponent, EquipmentData);
 
 	BroadcastSlotChangeMessage(NewEntry.SlotTag, NewEntry.Data, NewEntry.Instance);
+
+	OwnerComponent->RequestEquipmentPreload(NewEntry.SlotTag, NewEntry.Data);
 	
-	MarkItemDirty(NewEntry);
+	MarkEntryDirty(NewEntry);
 
 	return NewEntry.Instance;
 }
 
 UEquipmentInstance* FEquipmentContainer::RemoveEntry(FGameplayTag SlotTag)
 {
-	for (auto It{ Entries.CreateIterator() }; It; ++It)
+	GAEA_SCOPE_CYCLE_COUNTER("RemoveEntry", STAT_GAEA_RemoveEntry);
+
+	const auto Index{ FindEntryIndex(SlotTag) };
+
+	if (Index == INDEX_NONE)
 	{
-		auto& Entry{ *It };
+		return nullptr;
+	}
+
+	auto& Entry{ Entries[Index] };
+	auto Instance{ Entry.Instance };
+
+	if (Instance)
+	{
+		const auto& Data{ Entry.Data };
 
-		if (Entry.SlotTag == SlotTag)
+		if (Entry.bLocallyActivated)
 		{
-			auto Instance{ Entry.Instance };
+			DeactivateInstance(Entry);
+		}
 
-			if (Instance)
-			{
-				const auto& Data{ Entry.Data };
+		Instance->OnUnequiped(OwnerComponent, Data);
 
-				if (Entry.Activated)
-				{
-					Instance->OnDeactivated(OwnerComponent, Data);
-				}
+		BroadcastSlotChangeMessage(Entry.SlotTag);
+	}
 
-				Instance->OnUnequiped(OwnerComponent, Data);
+	// Remove entry and update the index of the entry moved into its place
 
-				BroadcastSlotChangeMessage(Entry.SlotTag);
-			}
+	const auto LastIndex{ Entries.Num() - 1 };
 
-			It.RemoveCurrent();
+	Entries.RemoveAtSwap(Index);
+	SlotIndexMap.Remove(SlotTag);
 
-			MarkArrayDirty();
+	if (ActiveEntryIndex == Index)
+	{
+		ActiveEntryIndex = INDEX_NONE;
+	}
+
+	if (Index != LastIndex)
+	{
+		SlotIndexMap.Add(Entries[Index].SlotTag, Index);
 
-			return Instance;
+		if (ActiveEntryIndex == LastIndex)
+		{
+			ActiveEntryIndex = Index;
 		}
 	}
 
-	return nullptr;
+	UpdateReplicatedActiveSlot();
+
+	MarkArrayDirty();
+
+	return Instance;
 }
 
 TArray<UEquipmentInstance*> FEquipmentContainer::RemoveAllEntries()
 {
+	GAEA_SCOPE_CYCLE_COUNTER("RemoveAllEntries", STAT_GAEA_RemoveAllEntries);
+
 	TArray<UEquipmentInstance*> RemovingInstances;
 
 	for (auto It{ Entries.CreateIterator() }; It; ++It)
@@ -196,9 +338,9 @@ TArray<UEquipmentInstance*> FEquipmentContainer::RemoveAllEntries()
 		{
 			const auto& Data{ Entry.Data };
 
-			if (Entry.Activated)
+			if (Entry.bLocallyActivated)
 			{
-				Instance->OnDeactivated(OwnerComponent, Data);
+				DeactivateInstance(Entry);
 			}
 
 			Instance->OnUnequiped(OwnerComponent, Data);
@@ -214,48 +356,499 @@ TArray<UEquipmentInstance*> FEquipmentContainer::RemoveAllEntries()
 
 	}
 
+	SlotIndexMap.Reset();
+	ActiveEntryIndex = INDEX_NONE;
+	bIndexCacheDirty = false;
+
+	UpdateReplicatedActiveSlot();
+
 	return RemovingInstances;
 }
 
 
 void FEquipmentContainer::ActivateEntry(int32 SlotIndex)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("ActivateEntry", STAT_GAEA_ActivateEntry);
+
 	if (Entries.IsValidIndex(SlotIndex))
 	{
 		auto& Entry{ Entries[SlotIndex] };
 
 		if (auto Instance{ Entry.Instance })
 		{
-			Instance->OnActivated(OwnerComponent, Entry.Data);
+			ActivateInstance(Entry);
 
 			BroadcastActiveSlotChangeMessage(Entry.SlotTag, Entry.Data, Entry.Instance);
 		}
 
 		Entry.Activated = true;
+		ActiveEntryIndex = SlotIndex;
 
-		MarkItemDirty(Entry);
+		if (IsActiveSlotReplicatedSeparately())
+		{
+			UpdateReplicatedActiveSlot();
+		}
+		else
+		{
+			MarkEntryDirty(Entry);
+		}
 	}
 }
 
 void FEquipmentContainer::DeactivateEntry(int32 SlotIndex)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("DeactivateEntry", STAT_GAEA_DeactivateEntry);
+
 	if (Entries.IsValidIndex(SlotIndex))
 	{
 		auto& Entry{ Entries[SlotIndex] };
 
-		if (auto Instance{ Entry.Instance })
+		if (Entry.Instance)
 		{
-			Instance->OnDeactivated(OwnerComponent, Entry.Data);
+			DeactivateInstance(Entry);
 		}
 
 		Entry.Activated = false;
 
-		MarkItemDirty(Entry);
+		if (ActiveEntryIndex == SlotIndex)
+		{
+			ActiveEntryIndex = INDEX_NONE;
+		}
+
+		if (IsActiveSlotReplicatedSeparately())
+		{
+			UpdateReplicatedActiveSlot();
+		}
+		else
+		{
+			MarkEntryDirty(Entry);
+		}
+	}
+}
+
+
+bool FEquipmentContainer::IsActiveSlotReplicatedSeparately() const
+{
+	return OwnerComponent && OwnerComponent->bReplicateActiveSlotSeparately;
+}
+
+void FEquipmentContainer::UpdateReplicatedActiveSlot()
+{
+	if (IsActiveSlotReplicatedSeparately() && OwnerComponent->HasAuthority())
+	{
+		const auto* ActiveEntry{ GetActiveEntry() };
+
+		OwnerComponent->ReplicatedActiveSlotTag = ActiveEntry ? ActiveEntry->SlotTag : FGameplayTag::EmptyTag;
+	}
+}
+
+void FEquipmentContainer::ApplyReplicatedActiveSlot(FGameplayTag SlotTag)
+{
+	// While predicting, only the authoritative state is updated until the prediction is resolved
+
+	if (IsActiveSlotPredicted())
+	{
+		for (auto& Entry : Entries)
+		{
+			Entry.Activated = SlotTag.IsValid() && (Entry.SlotTag == SlotTag);
+		}
+
+		OwnerComponent->ReconcileActiveSlotPrediction();
+		return;
+	}
+
+	const auto PrevIndex{ GetActiveEntryIndex() };
+	const auto NewIndex{ SlotTag.IsValid() ? FindEntryIndex(SlotTag) : INDEX_NONE };
+
+	if (PrevIndex == NewIndex)
+	{
+		return;
+	}
+
+	// Deactivate previous entry
+
+	if (Entries.IsValidIndex(PrevIndex))
+	{
+		auto& PrevEntry{ Entries[PrevIndex] };
+		PrevEntry.Activated = false;
+
+		if (PrevEntry.IsValid())
+		{
+			DeactivateInstance(PrevEntry);
+		}
+	}
+
+	ActiveEntryIndex = INDEX_NONE;
+
+	// Activate new entry. 
+	// If it has not been replicated yet, it is activated when added.
+
+	if (Entries.IsValidIndex(NewIndex))
+	{
+		auto& NewEntry{ Entries[NewIndex] };
+		NewEntry.Activated = true;
+		ActiveEntryIndex = NewIndex;
+
+		if (NewEntry.IsValid())
+		{
+			ActivateInstance(NewEntry);
+
+			BroadcastActiveSlotChangeMessage(NewEntry.SlotTag, NewEntry.Data, NewEntry.Instance);
+		}
+	}
+}
+
+
+bool FEquipmentContainer::IsActiveSlotPredicted() const
+{
+	return OwnerComponent && OwnerComponent->IsPredictingActiveSlot();
+}
+
+bool FEquipmentContainer::ShouldActivateLocally(const FEquipmentEntry& Entry) const
+{
+	if (IsActiveSlotPredicted())
+	{
+		return (Entry.SlotTag == OwnerComponent->PredictedActiveSlotTag);
+	}
+
+	return Entry.Activated;
+}
+
+int32 FEquipmentContainer::GetAuthoritativeActiveEntryIndex() const
+{
+	for (auto It{ Entries.CreateConstIterator() }; It; ++It)
+	{
+		if (It->Activated)
+		{
+			return It.GetIndex();
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FEquipmentContainer::ApplyLocalActiveEntry(int32 NewIndex)
+{
+	// Deactivate the other entries activated on this client
+
+	for (auto It{ Entries.CreateIterator() }; It; ++It)
+	{
+		if ((It.GetIndex() != NewIndex) && It->bLocallyActivated && It->IsValid())
+		{
+			DeactivateInstance(*It);
+		}
+	}
+
+	ActiveEntryIndex = Entries.IsValidIndex(NewIndex) ? NewIndex : INDEX_NONE;
+
+	// Activate new entry.
+	// If its instance has not been replicated yet, it is activated when equiped.
+
+	if (Entries.IsValidIndex(NewIndex))
+	{
+		auto& NewEntry{ Entries[NewIndex] };
+
+		if (NewEntry.bLocallyEquiped && !NewEntry.bLocallyActivated && NewEntry.IsValid())
+		{
+			ActivateInstance(NewEntry);
+
+			BroadcastActiveSlotChangeMessage(NewEntry.SlotTag, NewEntry.Data, NewEntry.Instance);
+		}
+	}
+}
+
+
+void FEquipmentContainer::MarkEntryDirty(FEquipmentEntry& Entry)
+{
+	if (IsInBatch())
+	{
+		PendingDirtySlotTags.AddUnique(Entry.SlotTag);
+		return;
+	}
+
+	MarkItemDirty(Entry);
+}
+
+
+void FEquipmentContainer::ActivateInstance(FEquipmentEntry& Entry)
+{
+	if (Entry.bLocallyActivated)
+	{
+		return;
+	}
+
+	Entry.bLocallyActivated = true;
+
+	// Fragments using the asset bundle are executed when it is loaded
+
+	OwnerComponent->DeferActivationUntilReady(Entry);
+
+	Entry.Instance->OnActivated(OwnerComponent, Entry.Data);
+}
+
+void FEquipmentContainer::DeactivateInstance(FEquipmentEntry& Entry)
+{
+	if (!Entry.bLocallyActivated)
+	{
+		return;
+	}
+
+	Entry.bLocallyActivated = false;
+
+	OwnerComponent->CancelDeferredActivation(Entry.SlotTag);
+
+	Entry.Instance->OnDeactivated(OwnerComponent, Entry.Data);
+}
+
+
+void FEquipmentContainer::BeginBatch()
+{
+	++BatchDepth;
+}
+
+void FEquipmentContainer::EndBatch()
+{
+	GAEA_SCOPE_CYCLE_COUNTER("EndBatch", STAT_GAEA_EndBatch);
+
+	check(BatchDepth > 0);
+
+	if (--BatchDepth > 0)
+	{
+		return;
+	}
+
+	// Mark entries that are still registered as dirty
+
+	for (const auto& SlotTag : PendingDirtySlotTags)
+	{
+		const auto Index{ FindEntryIndex(SlotTag) };
+
+		if (Entries.IsValidIndex(Index))
+		{
+			MarkItemDirty(Entries[Index]);
+		}
+	}
+
+	PendingDirtySlotTags.Reset();
+
+	// Broadcast final state of the changed slots now, or at the end of frame if deferred
+
+	if (IsDeferringMessages())
+	{
+		RequestDeferredFlush();
+	}
+	else
+	{
+		FlushPendingMessages();
 	}
 }
 
 
+bool FEquipmentContainer::IsDeferringMessages() const
+{
+	return OwnerComponent && OwnerComponent->bDeferSlotChangeMessages;
+}
+
+bool FEquipmentContainer::IsSendingSlotMessagesInBatch() const
+{
+	return OwnerComponent && OwnerComponent->bSendSlotMessagesInTransactions;
+}
+
+bool FEquipmentContainer::HasPendingMessages() const
+{
+	return !PendingChangedSlotTags.IsEmpty() || bPendingActiveSlotChange || !PendingBatchSlotTags.IsEmpty() || bPendingBatchActiveSlotChange;
+}
+
+void FEquipmentContainer::RequestDeferredFlush()
+{
+	if (!IsInBatch() && HasPendingMessages())
+	{
+		OwnerComponent->ScheduleSlotChangeMessageFlush();
+	}
+}
+
+void FEquipmentContainer::FlushPendingMessages()
+{
+	if (IsInBatch() || !HasPendingMessages())
+	{
+		return;
+	}
+
+	const auto ChangedSlotTags{ MoveTemp(PendingChangedSlotTags) };
+	const auto bActiveSlotChanged{ bPendingActiveSlotChange };
+	const auto BatchSlotTags{ MoveTemp(PendingBatchSlotTags) };
+	const auto bBatchActiveSlotChanged{ bPendingBatchActiveSlotChange };
+
+	PendingChangedSlotTags.Reset();
+	bPendingActiveSlotChange = false;
+	PendingBatchSlotTags.Reset();
+	bPendingBatchActiveSlotChange = false;
+
+	// Broadcast the slots changed outside of a batch one by one
+
+	for (const auto& SlotTag : ChangedSlotTags)
+	{
+		if (const auto* Entry{ FindEntry(SlotTag) })
+		{
+			SendSlotChangeMessage(Entry->SlotTag, Entry->Data, Entry->Instance);
+		}
+		else
+		{
+			SendSlotChangeMessage(SlotTag);
+		}
+	}
+
+	if (bActiveSlotChanged)
+	{
+		if (const auto* Entry{ GetActiveEntry() })
+		{
+			SendActiveSlotChangeMessage(Entry->SlotTag, Entry->Data, Entry->Instance);
+		}
+	}
+
+	// Broadcast the slots changed during the batch together
+
+	if (!BatchSlotTags.IsEmpty() || bBatchActiveSlotChanged)
+	{
+		SendSlotsChangeMessage(BatchSlotTags, bBatchActiveSlotChanged);
+
+		// Without the per-slot messages, still notify the listeners registered for the changed slots
+
+		if (!IsSendingSlotMessagesInBatch())
+		{
+			for (const auto& SlotTag : BatchSlotTags)
+			{
+				if (!ChangedSlotTags.Contains(SlotTag))
+				{
+					DispatchSlotChangeToListeners(SlotTag);
+				}
+			}
+
+			if (bBatchActiveSlotChanged && !bActiveSlotChanged)
+			{
+				DispatchActiveSlotChangeToListeners();
+			}
+		}
+	}
+}
+
+
+int32 FEquipmentContainer::FindEntryIndex(FGameplayTag SlotTag) const
+{
+	if (bIndexCacheDirty)
+	{
+		RebuildIndexCache();
+	}
+
+	const auto* Index{ SlotIndexMap.Find(SlotTag) };
+
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 FEquipmentContainer::GetActiveEntryIndex() const
+{
+	if (bIndexCacheDirty)
+	{
+		RebuildIndexCache();
+	}
+
+	return ActiveEntryIndex;
+}
+
+const FEquipmentEntry* FEquipmentContainer::FindEntry(FGameplayTag SlotTag) const
+{
+	const auto Index{ FindEntryIndex(SlotTag) };
+
+	return Entries.IsValidIndex(Index) ? &Entries[Index] : nullptr;
+}
+
+const FEquipmentEntry* FEquipmentContainer::GetActiveEntry() const
+{
+	const auto Index{ GetActiveEntryIndex() };
+
+	return Entries.IsValidIndex(Index) ? &Entries[Index] : nullptr;
+}
+
+void FEquipmentContainer::RebuildIndexCache() const
+{
+	SlotIndexMap.Reset();
+	ActiveEntryIndex = INDEX_NONE;
+
+	for (auto It{ Entries.CreateConstIterator() }; It; ++It)
+	{
+		const auto& Entry{ *It };
+
+		SlotIndexMap.FindOrAdd(Entry.SlotTag, It.GetIndex());
+
+		if (Entry.Activated)
+		{
+			ActiveEntryIndex = It.GetIndex();
+		}
+	}
+
+	// The predicted active slot takes precedence on the client
+
+	if (IsActiveSlotPredicted())
+	{
+		const auto* PredictedIndex{ SlotIndexMap.Find(OwnerComponent->PredictedActiveSlotTag) };
+
+		ActiveEntryIndex = PredictedIndex ? *PredictedIndex : INDEX_NONE;
+	}
+
+	bIndexCacheDirty = false;
+}
+
+
 void FEquipmentContainer::BroadcastSlotChangeMessage(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, UEquipmentInstance* Instance)
+{
+	if (IsInBatch())
+	{
+		PendingBatchSlotTags.AddUnique(SlotTag);
+
+		if (IsSendingSlotMessagesInBatch())
+		{
+			PendingChangedSlotTags.AddUnique(SlotTag);
+		}
+
+		return;
+	}
+
+	if (IsDeferringMessages())
+	{
+		PendingChangedSlotTags.AddUnique(SlotTag);
+		RequestDeferredFlush();
+		return;
+	}
+
+	SendSlotChangeMessage(SlotTag, EquipmentData, Instance);
+}
+
+void FEquipmentContainer::BroadcastActiveSlotChangeMessage(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, UEquipmentInstance* Instance)
+{
+	if (IsInBatch())
+	{
+		bPendingBatchActiveSlotChange = true;
+
+		if (IsSendingSlotMessagesInBatch())
+		{
+			bPendingActiveSlotChange = true;
+		}
+
+		return;
+	}
+
+	if (IsDeferringMessages())
+	{
+		bPendingActiveSlotChange = true;
+		RequestDeferredFlush();
+		return;
+	}
+
+	SendActiveSlotChangeMessage(SlotTag, EquipmentData, Instance);
+}
+
+
+void FEquipmentContainer::SendSlotChangeMessage(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, UEquipmentInstance* Instance)
 {
 	FEquipmentSlotChangedMessage Message;
 	Message.OwnerComponent = OwnerComponent;
@@ -266,10 +859,12 @@ void FEquipmentContainer::BroadcastSlotChangeMessage(FGameplayTag SlotTag, const
 	auto& MessageSystem{ UGameplayMessageSubsystem::Get(OwnerComponent->GetWorld()) };
 	MessageSystem.BroadcastMessage(TAG_Message_Equipment_SlotChange, Message);
 
+	OwnerComponent->DispatchSlotChangeToListeners(Message);
+	OwnerComponent->OnEquipmentSlotChangeNative.Broadcast(Message);
 	OwnerComponent->OnEquipmentSlotChange.Broadcast(Message);
 }
 
-void FEquipmentContainer::BroadcastActiveSlotChangeMessage(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, UEquipmentInstance* Instance)
+void FEquipmentContainer::SendActiveSlotChangeMessage(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, UEquipmentInstance* Instance)
 {
 	FEquipmentSlotChangedMessage Message;
 	Message.OwnerComponent = OwnerComponent;
@@ -280,7 +875,57 @@ void FEquipmentContainer::BroadcastActiveSlotChangeMessage(FGameplayTag SlotTag,
 	auto& MessageSystem{ UGameplayMessageSubsystem::Get(OwnerComponent->GetWorld()) };
 	MessageSystem.BroadcastMessage(TAG_Message_Equipment_ActiveSlotChange, Message);
 
+	OwnerComponent->DispatchActiveSlotChangeToListeners(Message);
+	OwnerComponent->OnActiveEquipmentSlotChangeNative.Broadcast(Message);
 	OwnerComponent->OnActiveEquipmentSlotChange.Broadcast(Message);
 }
 
+void FEquipmentContainer::DispatchSlotChangeToListeners(FGameplayTag SlotTag) const
+{
+	const auto* Entry{ FindEntry(SlotTag) };
+
+	FEquipmentSlotChangedMessage Message;
+	Message.OwnerComponent = OwnerComponent;
+	Message.SlotTag = SlotTag;
+	Message.Data = Entry ? Entry->Data : nullptr;
+	Message.Instance = Entry ? Entry->Instance : nullptr;
+
+	OwnerComponent->DispatchSlotChangeToListeners(Message);
+}
+
+void FEquipmentContainer::DispatchActiveSlotChangeToListeners()
+{
+	const auto* Entry{ GetActiveEntry() };
+
+	if (!Entry)
+	{
+		return;
+	}
+
+	FEquipmentSlotChangedMessage Message;
+	Message.OwnerComponent = OwnerComponent;
+	Message.SlotTag = Entry->SlotTag;
+	Message.Data = Entry->Data;
+	Message.Instance = Entry->Instance;
+
+	OwnerComponent->DispatchActiveSlotChangeToListeners(Message);
+}
+
+void FEquipmentContainer::SendSlotsChangeMessage(const TArray<FGameplayTag>& SlotTags, bool bActiveSlotChanged)
+{
+	const auto* ActiveEntry{ GetActiveEntry() };
+
+	FEquipmentSlotsChangedMessage Message;
+	Message.OwnerComponent = OwnerComponent;
+	Message.SlotTags = SlotTags;
+	Message.ActiveSlotTag = ActiveEntry ? ActiveEntry->SlotTag : FGameplayTag::EmptyTag;
+	Message.bActiveSlotChanged = bActiveSlotChanged;
+
+	auto& MessageSystem{ UGameplayMessageSubsystem::Get(OwnerComponent->GetWorld()) };
+	MessageSystem.BroadcastMessage(TAG_Message_Equipment_SlotsChange, Message);
+
+	OwnerComponent->OnEquipmentSlotsChangeNative.Broadcast(Message);
+	OwnerComponent->OnEquipmentSlotsChange.Broadcast(Message);
+}
+
 #pragma endregion
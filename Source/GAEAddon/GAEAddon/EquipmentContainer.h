@@ -5,6 +5,7 @@
 #include "Net/Serialization/FastArraySerializer.h"
 
 #include "GameplayTagContainer.h"
+#include "UObject/CoreNetTypes.h"
 
 #include "EquipmentContainer.generated.h"
 
@@ -42,6 +43,27 @@ public:
 	UPROPERTY()
 	uint8 Activated : 1;
 
+	//
+	// Whether OnEquiped has been executed for the Instance on this client
+	// 
+	// Note:
+	//	Not replicated. Instance may be received later than the entry depending on the replication policy.
+	//
+	bool bLocallyEquiped{ false };
+
+	//
+	// Whether OnActivated has been executed (or delayed until the Equipment is ready) for the Instance on this machine
+	// 
+	// Note:
+	//	Not replicated. May differ from Activated while the active slot is predicted by the client.
+	//
+	bool bLocallyActivated{ false };
+
+	//
+	// Net condition with which the Instance is registered as a replicated subobject, or COND_Max if not registered
+	//
+	ELifetimeCondition RegisteredNetCondition{ COND_Max };
+
 public:
 	FString GetDebugString() const;
 
@@ -78,6 +100,25 @@ protected:
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UEquipmentManagerComponent> OwnerComponent;
 
+	//
+	// Index of the Entry registered in each slot
+	// 
+	// Note:
+	//	Not replicated. It is updated on the server when the entries are changed 
+	//	and is rebuilt on the client from the replication callbacks.
+	//
+	mutable TMap<FGameplayTag, int32> SlotIndexMap;
+
+	//
+	// Index of the currently activated Entry
+	//
+	mutable int32 ActiveEntryIndex{ INDEX_NONE };
+
+	//
+	// Whether SlotIndexMap and ActiveEntryIndex need to be rebuilt before next use
+	//
+	mutable bool bIndexCacheDirty{ false };
+
 public:
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
@@ -96,6 +137,135 @@ protected:
 	void ActivateEntry(int32 SlotIndex);
 	void DeactivateEntry(int32 SlotIndex);
 
+	void MarkEntryDirty(FEquipmentEntry& Entry);
+
+	/**
+	 * Activate the instance of the Entry.
+	 * If the asset bundles of the Equipment are still loading, the fragments using them are delayed until they are loaded.
+	 */
+	void ActivateInstance(FEquipmentEntry& Entry);
+
+	/**
+	 * Deactivate the instance of the Entry.
+	 * If the activation of the fragments using the asset bundles is still delayed, it is cancelled.
+	 */
+	void DeactivateInstance(FEquipmentEntry& Entry);
+
+	/**
+	 * Executes OnEquiped and activation for the entry received from the server
+	 */
+	void EquipReplicatedEntry(FEquipmentEntry& Entry);
+
+protected:
+	/**
+	 * Returns whether the active slot is replicated by the owner component instead of the Activated of each entry
+	 */
+	bool IsActiveSlotReplicatedSeparately() const;
+
+	/**
+	 * Copy the current active slot to the replicated active slot of the owner component (server only)
+	 */
+	void UpdateReplicatedActiveSlot();
+
+	/**
+	 * Change the active entry to the slot received from the server (client only)
+	 */
+	void ApplyReplicatedActiveSlot(FGameplayTag SlotTag);
+
+protected:
+	/**
+	 * Returns whether the active slot is currently predicted by the owner component (client only)
+	 */
+	bool IsActiveSlotPredicted() const;
+
+	/**
+	 * Returns whether the instance of the entry should be activated on this machine
+	 */
+	bool ShouldActivateLocally(const FEquipmentEntry& Entry) const;
+
+	/**
+	 * Returns the index of the entry activated by the server, ignoring the prediction. If not, INDEX_NONE is returned.
+	 */
+	int32 GetAuthoritativeActiveEntryIndex() const;
+
+	/**
+	 * Executes OnActivated/OnDeactivated on this client so that only the specified entry is activated (client only)
+	 */
+	void ApplyLocalActiveEntry(int32 NewIndex);
+
+protected:
+	//
+	// Number of nested batches currently open
+	//
+	int32 BatchDepth{ 0 };
+
+	//
+	// Slots whose Equipment has been changed since the last deferred flush, broadcast one SlotChange message each
+	//
+	TArray<FGameplayTag> PendingChangedSlotTags;
+
+	//
+	// Slots whose entry has been marked dirty during the batch
+	//
+	TArray<FGameplayTag> PendingDirtySlotTags;
+
+	//
+	// Whether the active slot has been changed since the last deferred flush
+	//
+	bool bPendingActiveSlotChange{ false };
+
+	//
+	// Slots whose Equipment has been changed during the batch, broadcast together in one SlotsChange message
+	//
+	TArray<FGameplayTag> PendingBatchSlotTags;
+
+	//
+	// Whether the active slot has been changed during the batch
+	//
+	bool bPendingBatchActiveSlotChange{ false };
+
+protected:
+	/**
+	 * Starts collecting changes to the entries.
+	 * Messages and dirty marks are held until the last batch is ended.
+	 */
+	void BeginBatch();
+
+	/**
+	 * Ends the batch.
+	 * When the last batch is ended, the changed entries are marked dirty once and one SlotsChange message is broadcast for all changed slots.
+	 * SlotChange and ActiveSlotChange are only broadcast per slot when the owner component enables bSendSlotMessagesInTransactions.
+	 */
+	void EndBatch();
+
+	bool IsInBatch() const { return BatchDepth > 0; }
+
+public:
+	/**
+	 * Returns the index of the Entry registered in the specified slot. If not, INDEX_NONE is returned.
+	 */
+	int32 FindEntryIndex(FGameplayTag SlotTag) const;
+
+	/**
+	 * Returns the index of the activated Entry. If not, INDEX_NONE is returned.
+	 */
+	int32 GetActiveEntryIndex() const;
+
+	/**
+	 * Returns the Entry registered in the specified slot. If not, nullptr is returned.
+	 */
+	const FEquipmentEntry* FindEntry(FGameplayTag SlotTag) const;
+
+	/**
+	 * Returns the activated Entry. If not, nullptr is returned.
+	 */
+	const FEquipmentEntry* GetActiveEntry() const;
+
+	const TArray<FEquipmentEntry>& GetEntries() const { return Entries; }
+
+protected:
+	void RebuildIndexCache() const;
+
 
 protected:
 	void BroadcastSlotChangeMessage(
@@ -108,6 +278,45 @@ protected:
 		const UEquipmentData* EquipmentData = nullptr,
 		UEquipmentInstance* Instance = nullptr);
 
+	void SendSlotChangeMessage(
+		FGameplayTag SlotTag = FGameplayTag::EmptyTag,
+		const UEquipmentData* EquipmentData = nullptr,
+		UEquipmentInstance* Instance = nullptr);
+
+	void SendActiveSlotChangeMessage(
+		FGameplayTag SlotTag = FGameplayTag::EmptyTag,
+		const UEquipmentData* EquipmentData = nullptr,
+		UEquipmentInstance* Instance = nullptr);
+
+	void DispatchSlotChangeToListeners(FGameplayTag SlotTag) const;
+	void DispatchActiveSlotChangeToListeners();
+
+	void SendSlotsChangeMessage(const TArray<FGameplayTag>& SlotTags, bool bActiveSlotChanged);
+
+protected:
+	/**
+	 * Returns whether messages are held until the end of frame by the owner component
+	 */
+	bool IsDeferringMessages() const;
+
+	/**
+	 * Returns whether SlotChange and ActiveSlotChange are also broadcast for each slot changed during a batch
+	 */
+	bool IsSendingSlotMessagesInBatch() const;
+
+	bool HasPendingMessages() const;
+
+	/**
+	 * Ask the owner component to flush held messages at the end of frame
+	 */
+	void RequestDeferredFlush();
+
+	/**
+	 * Broadcasts the final state of the slots changed since the last flush.
+	 * Deferred changes are broadcast once per slot, changes made during a batch are broadcast together in one SlotsChange message.
+	 */
+	void FlushPendingMessages();
+
 };
 
 template<>
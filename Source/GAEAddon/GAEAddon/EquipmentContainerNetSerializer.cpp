@@ -0,0 +1,367 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentContainerNetSerializer.h"
+
+#include "EquipmentContainer.h"
+#include "EquipmentData.h"
+#include "EquipmentInstance.h"
+
+#include "GameplayTagsManager.h"
+
+#if UE_WITH_IRIS
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializationContext.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "Iris/Serialization/ObjectNetSerializer.h"
+#endif // UE_WITH_IRIS
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentContainerNetSerializer)
+
+
+#if UE_WITH_IRIS
+
+namespace UE::Net
+{
+	/**
+	 * Iris NetSerializer of the entries replicated in FEquipmentContainer.
+	 * 
+	 * Tips:
+	 *	The slot tag is quantized to its gameplay tag net index, and Data and Instance to object references.
+	 *	When only Activated has changed since the baseline, only the activation bit is sent.
+	 * 
+	 * Note:
+	 *	The activation-only delta is used when delta compression is enabled for the owner in the Iris config.
+	 */
+	struct FEquipmentEntryNetSerializer
+	{
+	public:
+		static const uint32 Version{ 0 };
+
+		static constexpr bool bHasCustomNetReference{ true };
+
+		//
+		// Storage for the quantized state of FObjectNetSerializer, whose type is not public
+		//
+		static constexpr uint32 QuantizedReferenceSize{ 32 };
+		static constexpr uint32 QuantizedReferenceAlignment{ 16 };
+
+		struct FQuantizedType
+		{
+			alignas(QuantizedReferenceAlignment) uint8 DataReference[QuantizedReferenceSize];
+			alignas(QuantizedReferenceAlignment) uint8 InstanceReference[QuantizedReferenceSize];
+
+			uint16 SlotTagNetIndex;
+			uint8 bActivated;
+		};
+
+		typedef FEquipmentEntry SourceType;
+		typedef FQuantizedType QuantizedType;
+		typedef FEquipmentEntryNetSerializerConfig ConfigType;
+
+		static const ConfigType DefaultConfig;
+
+	public:
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+
+		static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args);
+		static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args);
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+		static void CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args);
+
+	private:
+		static const FNetSerializer& GetObjectSerializer() { return UE_NET_GET_SERIALIZER(FObjectNetSerializer); }
+
+		static uint32 GetSlotTagNumBits() { return static_cast<uint32>(FMath::Max(UGameplayTagsManager::Get().GetNetIndexTrueBitNum(), 1)); }
+
+		static void SerializeReference(FNetSerializationContext& Context, const uint8* Reference);
+		static void DeserializeReference(FNetSerializationContext& Context, uint8* Reference);
+		static void QuantizeReference(FNetSerializationContext& Context, UObject* Object, uint8* Reference);
+		static UObject* DequantizeReference(FNetSerializationContext& Context, const uint8* Reference);
+		static bool IsEqualReference(FNetSerializationContext& Context, const uint8* Reference0, const uint8* Reference1);
+
+		class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+		{
+		public:
+			virtual ~FNetSerializerRegistryDelegates();
+
+		private:
+			virtual void OnPreFreezeNetSerializerRegistry() override;
+		};
+
+		static FEquipmentEntryNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+	};
+
+	UE_NET_IMPLEMENT_SERIALIZER(FEquipmentEntryNetSerializer);
+
+	const FEquipmentEntryNetSerializer::ConfigType FEquipmentEntryNetSerializer::DefaultConfig;
+
+	FEquipmentEntryNetSerializer::FNetSerializerRegistryDelegates FEquipmentEntryNetSerializer::NetSerializerRegistryDelegates;
+
+
+#pragma region Registration
+
+	static const FName PropertyNetSerializerRegistry_NAME_EquipmentEntry("EquipmentEntry");
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_EquipmentEntry, FEquipmentEntryNetSerializer);
+
+	FEquipmentEntryNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_EquipmentEntry);
+	}
+
+	void FEquipmentEntryNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+	{
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		checkf((ObjectSerializer.QuantizedTypeSize <= QuantizedReferenceSize) && (ObjectSerializer.QuantizedTypeAlignment <= QuantizedReferenceAlignment),
+			TEXT("Quantized object reference (size %u, alignment %u) does not fit in FEquipmentEntryNetSerializer."),
+			ObjectSerializer.QuantizedTypeSize, ObjectSerializer.QuantizedTypeAlignment);
+
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_EquipmentEntry);
+	}
+
+#pragma endregion
+
+
+#pragma region Object References
+
+	void FEquipmentEntryNetSerializer::SerializeReference(FNetSerializationContext& Context, const uint8* Reference)
+	{
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		FNetSerializeArgs ObjectArgs{};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam(ObjectSerializer.DefaultConfig);
+		ObjectArgs.Source = NetSerializerValuePointer(Reference);
+
+		ObjectSerializer.Serialize(Context, ObjectArgs);
+	}
+
+	void FEquipmentEntryNetSerializer::DeserializeReference(FNetSerializationContext& Context, uint8* Reference)
+	{
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		FNetDeserializeArgs ObjectArgs{};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam(ObjectSerializer.DefaultConfig);
+		ObjectArgs.Target = NetSerializerValuePointer(Reference);
+
+		ObjectSerializer.Deserialize(Context, ObjectArgs);
+	}
+
+	void FEquipmentEntryNetSerializer::QuantizeReference(FNetSerializationContext& Context, UObject* Object, uint8* Reference)
+	{
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		FNetQuantizeArgs ObjectArgs{};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam(ObjectSerializer.DefaultConfig);
+		ObjectArgs.Source = NetSerializerValuePointer(&Object);
+		ObjectArgs.Target = NetSerializerValuePointer(Reference);
+
+		ObjectSerializer.Quantize(Context, ObjectArgs);
+	}
+
+	UObject* FEquipmentEntryNetSerializer::DequantizeReference(FNetSerializationContext& Context, const uint8* Reference)
+	{
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		UObject* Object{ nullptr };
+
+		FNetDequantizeArgs ObjectArgs{};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam(ObjectSerializer.DefaultConfig);
+		ObjectArgs.Source = NetSerializerValuePointer(Reference);
+		ObjectArgs.Target = NetSerializerValuePointer(&Object);
+
+		ObjectSerializer.Dequantize(Context, ObjectArgs);
+
+		return Object;
+	}
+
+	bool FEquipmentEntryNetSerializer::IsEqualReference(FNetSerializationContext& Context, const uint8* Reference0, const uint8* Reference1)
+	{
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		FNetIsEqualArgs ObjectArgs{};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam(ObjectSerializer.DefaultConfig);
+		ObjectArgs.Source0 = NetSerializerValuePointer(Reference0);
+		ObjectArgs.Source1 = NetSerializerValuePointer(Reference1);
+		ObjectArgs.bStateIsQuantized = true;
+
+		return ObjectSerializer.IsEqual(Context, ObjectArgs);
+	}
+
+#pragma endregion
+
+
+#pragma region Serialize
+
+	void FEquipmentEntryNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+	{
+		const auto& Value{ *reinterpret_cast<const QuantizedType*>(Args.Source) };
+
+		auto* Writer{ Context.GetBitStreamWriter() };
+		Writer->WriteBits(Value.SlotTagNetIndex, GetSlotTagNumBits());
+		Writer->WriteBool(Value.bActivated != 0);
+
+		SerializeReference(Context, Value.DataReference);
+		SerializeReference(Context, Value.InstanceReference);
+	}
+
+	void FEquipmentEntryNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+	{
+		auto& Target{ *reinterpret_cast<QuantizedType*>(Args.Target) };
+
+		auto* Reader{ Context.GetBitStreamReader() };
+		Target.SlotTagNetIndex = static_cast<uint16>(Reader->ReadBits(GetSlotTagNumBits()));
+		Target.bActivated = Reader->ReadBool() ? 1 : 0;
+
+		DeserializeReference(Context, Target.DataReference);
+		DeserializeReference(Context, Target.InstanceReference);
+	}
+
+	void FEquipmentEntryNetSerializer::SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+	{
+		const auto& Value{ *reinterpret_cast<const QuantizedType*>(Args.Source) };
+		const auto& PrevValue{ *reinterpret_cast<const QuantizedType*>(Args.Prev) };
+
+		// Activating and deactivating the Equipment in a slot is the most frequent change, which only needs the activation bit
+
+		const auto bOnlyActivationChanged
+		{
+			(Value.SlotTagNetIndex == PrevValue.SlotTagNetIndex) &&
+			IsEqualReference(Context, Value.DataReference, PrevValue.DataReference) &&
+			IsEqualReference(Context, Value.InstanceReference, PrevValue.InstanceReference)
+		};
+
+		auto* Writer{ Context.GetBitStreamWriter() };
+
+		if (Writer->WriteBool(bOnlyActivationChanged))
+		{
+			Writer->WriteBool(Value.bActivated != 0);
+		}
+		else
+		{
+			FNetSerializeArgs SerializeArgs{};
+			SerializeArgs.NetSerializerConfig = Args.NetSerializerConfig;
+			SerializeArgs.Source = Args.Source;
+
+			Serialize(Context, SerializeArgs);
+		}
+	}
+
+	void FEquipmentEntryNetSerializer::DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
+	{
+		auto& Target{ *reinterpret_cast<QuantizedType*>(Args.Target) };
+		const auto& PrevValue{ *reinterpret_cast<const QuantizedType*>(Args.Prev) };
+
+		auto* Reader{ Context.GetBitStreamReader() };
+
+		if (Reader->ReadBool())
+		{
+			Target = PrevValue;
+			Target.bActivated = Reader->ReadBool() ? 1 : 0;
+		}
+		else
+		{
+			FNetDeserializeArgs DeserializeArgs{};
+			DeserializeArgs.NetSerializerConfig = Args.NetSerializerConfig;
+			DeserializeArgs.Target = Args.Target;
+
+			Deserialize(Context, DeserializeArgs);
+		}
+	}
+
+#pragma endregion
+
+
+#pragma region Quantize
+
+	void FEquipmentEntryNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+	{
+		const auto& Source{ *reinterpret_cast<const SourceType*>(Args.Source) };
+		auto& Target{ *reinterpret_cast<QuantizedType*>(Args.Target) };
+
+		Target.SlotTagNetIndex = UGameplayTagsManager::Get().GetNetIndexFromTag(Source.SlotTag);
+		Target.bActivated = Source.Activated ? 1 : 0;
+
+		QuantizeReference(Context, const_cast<UEquipmentData*>(Source.Data.Get()), Target.DataReference);
+		QuantizeReference(Context, Source.Instance.Get(), Target.InstanceReference);
+	}
+
+	void FEquipmentEntryNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+	{
+		const auto& Source{ *reinterpret_cast<const QuantizedType*>(Args.Source) };
+		auto& Target{ *reinterpret_cast<SourceType*>(Args.Target) };
+
+		// Only the replicated members are written, the local state of the entry is kept
+
+		const auto& TagManager{ UGameplayTagsManager::Get() };
+
+		Target.SlotTag = (Source.SlotTagNetIndex < TagManager.GetInvalidTagNetIndex())
+			? FGameplayTag::RequestGameplayTag(TagManager.GetTagNameFromNetIndex(Source.SlotTagNetIndex), false)
+			: FGameplayTag::EmptyTag;
+
+		Target.Activated = (Source.bActivated != 0);
+
+		Target.Data = Cast<UEquipmentData>(DequantizeReference(Context, Source.DataReference));
+		Target.Instance = Cast<UEquipmentInstance>(DequantizeReference(Context, Source.InstanceReference));
+	}
+
+	bool FEquipmentEntryNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+	{
+		if (Args.bStateIsQuantized)
+		{
+			const auto& Value0{ *reinterpret_cast<const QuantizedType*>(Args.Source0) };
+			const auto& Value1{ *reinterpret_cast<const QuantizedType*>(Args.Source1) };
+
+			return (Value0.SlotTagNetIndex == Value1.SlotTagNetIndex)
+				&& (Value0.bActivated == Value1.bActivated)
+				&& IsEqualReference(Context, Value0.DataReference, Value1.DataReference)
+				&& IsEqualReference(Context, Value0.InstanceReference, Value1.InstanceReference);
+		}
+
+		const auto& Value0{ *reinterpret_cast<const SourceType*>(Args.Source0) };
+		const auto& Value1{ *reinterpret_cast<const SourceType*>(Args.Source1) };
+
+		return (Value0.SlotTag == Value1.SlotTag)
+			&& (Value0.Activated == Value1.Activated)
+			&& (Value0.Data == Value1.Data)
+			&& (Value0.Instance == Value1.Instance);
+	}
+
+	bool FEquipmentEntryNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+	{
+		const auto& Source{ *reinterpret_cast<const SourceType*>(Args.Source) };
+
+		// The slot tag must have a net index, or it would arrive as another tag
+
+		const auto& TagManager{ UGameplayTagsManager::Get() };
+
+		return !Source.SlotTag.IsValid() || (TagManager.GetNetIndexFromTag(Source.SlotTag) < TagManager.GetInvalidTagNetIndex());
+	}
+
+	void FEquipmentEntryNetSerializer::CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args)
+	{
+		const auto& Value{ *reinterpret_cast<const QuantizedType*>(Args.Source) };
+		const auto& ObjectSerializer{ GetObjectSerializer() };
+
+		for (const auto* Reference : { Value.DataReference, Value.InstanceReference })
+		{
+			FNetCollectReferencesArgs ObjectArgs{ Args };
+			ObjectArgs.NetSerializerConfig = NetSerializerConfigParam(ObjectSerializer.DefaultConfig);
+			ObjectArgs.Source = NetSerializerValuePointer(Reference);
+
+			ObjectSerializer.CollectNetReferences(Context, ObjectArgs);
+		}
+	}
+
+#pragma endregion
+
+}
+
+#endif // UE_WITH_IRIS
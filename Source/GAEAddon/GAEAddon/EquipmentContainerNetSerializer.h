@@ -0,0 +1,20 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Iris/Serialization/NetSerializer.h"
+
+#include "EquipmentContainerNetSerializer.generated.h"
+
+
+/**
+ * Config of the Iris NetSerializer used for FEquipmentEntry in FEquipmentContainer
+ */
+USTRUCT()
+struct FEquipmentEntryNetSerializerConfig : public FNetSerializerConfig
+{
+	GENERATED_BODY()
+public:
+	FEquipmentEntryNetSerializerConfig() {}
+
+};
@@ -6,12 +6,24 @@
 #include "Fragment/EquipmentFragmentBase.h"
 #include "EquipmentInstance.h"
 #include "GAEAddonLogs.h"
+#include "GAEAddonStats.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentData)
 
 
+const FName UEquipmentData::NAME_EquipmentBundle("Equipment");
+
+
 #define LOCTEXT_NAMESPACE "EquipmentData"
 
+void UEquipmentData::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildPhaseFragments();
+}
+
+
 #if WITH_EDITOR
 EDataValidationResult UEquipmentData::IsDataValid(TArray<FText>& ValidationErrors)
 {
@@ -95,6 +107,16 @@ EDataValidationResult UEquipmentData::IsDataValid(TArray<FText>& ValidationError
 
 	return Result;
 }
+
+void UEquipmentData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Fragments may have been added, removed or replaced
+
+	InvalidateFragmentClassCache();
+	InvalidatePhaseFragments();
+}
 #endif
 
 #if WITH_EDITORONLY_DATA
@@ -113,61 +135,272 @@ void UEquipmentData::UpdateAssetBundleData()
 #endif
 
 
+bool UEquipmentData::IsSlotAllowed(FGameplayTag SlotTag) const
+{
+	return AllowedSlotTags.IsEmpty() || AllowedSlotTags.HasTag(SlotTag);
+}
+
+
 void UEquipmentData::HandleEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
 {
-	UE_LOG(LogGAEA, Log, TEXT("%s::HandleEquiped: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+	GAEA_SCOPE_CYCLE_COUNTER("HandleEquiped", STAT_GAEA_HandleEquiped);
 
-	for (const auto& Fragment : Fragments)
+	GAEALIFECYCLELOG(Instance, TEXT("%s::HandleEquiped: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+
+	const auto& PhaseFragments{ GetPhaseFragments(EEquipmentFragmentPhase::Equiped) };
+
+	if (PhaseFragments.IsEmpty())
 	{
-		Fragment->OnEquiped(EMC, Instance);
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_GAEA_FragmentCalls_Equiped, PhaseFragments.Num());
+
+	const FEquipmentFragmentContext Context{ EMC, Instance };
+
+	for (const auto& Fragment : PhaseFragments)
+	{
+		GAEA_TRACE_SCOPE_DYNAMIC(Fragment->GetClass()->GetName() + TEXT("::OnEquiped"));
+
+		Fragment->OnEquiped(Context);
 	}
 }
 
 void UEquipmentData::HandleUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
 {
-	UE_LOG(LogGAEA, Log, TEXT("%s::HandleUnequiped: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+	GAEA_SCOPE_CYCLE_COUNTER("HandleUnequiped", STAT_GAEA_HandleUnequiped);
 
-	for (const auto& Fragment : Fragments)
+	GAEALIFECYCLELOG(Instance, TEXT("%s::HandleUnequiped: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+
+	const auto& PhaseFragments{ GetPhaseFragments(EEquipmentFragmentPhase::Unequiped) };
+
+	if (PhaseFragments.IsEmpty())
+	{
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_GAEA_FragmentCalls_Unequiped, PhaseFragments.Num());
+
+	const FEquipmentFragmentContext Context{ EMC, Instance };
+
+	for (const auto& Fragment : PhaseFragments)
 	{
-		Fragment->OnUnequiped(EMC, Instance);
+		GAEA_TRACE_SCOPE_DYNAMIC(Fragment->GetClass()->GetName() + TEXT("::OnUnequiped"));
+
+		Fragment->OnUnequiped(Context);
 	}
 }
 
 void UEquipmentData::HandleActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
 {
-	UE_LOG(LogGAEA, Log, TEXT("%s::HandleActivated: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+	GAEA_SCOPE_CYCLE_COUNTER("HandleActivated", STAT_GAEA_HandleActivated);
 
-	for (const auto& Fragment : Fragments)
+	GAEALIFECYCLELOG(Instance, TEXT("%s::HandleActivated: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+
+	const auto& PhaseFragments{ GetPhaseFragments(EEquipmentFragmentPhase::Activated) };
+
+	if (PhaseFragments.IsEmpty())
 	{
-		Fragment->OnActivated(EMC, Instance);
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_GAEA_FragmentCalls_Activated, PhaseFragments.Num());
+
+	const FEquipmentFragmentContext Context{ EMC, Instance };
+
+	// Fragments using the asset bundle are delayed while it is being loaded
+
+	const auto bBundleReady{ EMC->IsEquipmentDataReady(this) };
+
+	for (const auto& Fragment : PhaseFragments)
+	{
+		if (!bBundleReady && Fragment->RequiresEquipmentBundle())
+		{
+			continue;
+		}
+
+		GAEA_TRACE_SCOPE_DYNAMIC(Fragment->GetClass()->GetName() + TEXT("::OnActivated"));
+
+		Fragment->OnActivated(Context);
 	}
 }
 
 void UEquipmentData::HandleDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
 {
-	UE_LOG(LogGAEA, Log, TEXT("%s::HandleDeactivated: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+	GAEA_SCOPE_CYCLE_COUNTER("HandleDeactivated", STAT_GAEA_HandleDeactivated);
 
-	for (const auto& Fragment : Fragments)
+	GAEALIFECYCLELOG(Instance, TEXT("%s::HandleDeactivated: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+
+	const auto& PhaseFragments{ GetPhaseFragments(EEquipmentFragmentPhase::Deactivated) };
+
+	if (PhaseFragments.IsEmpty())
+	{
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_GAEA_FragmentCalls_Deactivated, PhaseFragments.Num());
+
+	const FEquipmentFragmentContext Context{ EMC, Instance };
+
+	// Fragments using the asset bundle are delayed while it is being loaded
+
+	const auto bBundleReady{ EMC->IsEquipmentDataReady(this) };
+
+	for (const auto& Fragment : PhaseFragments)
+	{
+		if (!bBundleReady && Fragment->RequiresEquipmentBundle())
+		{
+			continue;
+		}
+
+		GAEA_TRACE_SCOPE_DYNAMIC(Fragment->GetClass()->GetName() + TEXT("::OnDeactivated"));
+
+		Fragment->OnDeactivated(Context);
+	}
+}
+
+
+void UEquipmentData::HandleDeferredActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+{
+	GAEA_SCOPE_CYCLE_COUNTER("HandleDeferredActivated", STAT_GAEA_HandleDeferredActivated);
+
+	GAEALIFECYCLELOG(Instance, TEXT("%s::HandleDeferredActivated: Execute fragments (EMC:%s, Ins:%s)"), *GetNameSafe(this), *GetNameSafe(EMC), *GetNameSafe(Instance));
+
+	const auto& PhaseFragments{ GetPhaseFragments(EEquipmentFragmentPhase::Activated) };
+
+	if (PhaseFragments.IsEmpty())
 	{
-		Fragment->OnDeactivated(EMC, Instance);
+		return;
+	}
+
+	const FEquipmentFragmentContext Context{ EMC, Instance };
+
+	for (const auto& Fragment : PhaseFragments)
+	{
+		if (!Fragment->RequiresEquipmentBundle())
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_GAEA_FragmentCalls_Activated);
+
+		GAEA_TRACE_SCOPE_DYNAMIC(Fragment->GetClass()->GetName() + TEXT("::OnActivated"));
+
+		Fragment->OnActivated(Context);
 	}
 }
 
 
 const UEquipmentFragmentBase* UEquipmentData::FindFragmentByClass(TSubclassOf<UEquipmentFragmentBase> FragmentClass) const
 {
-	if (FragmentClass != nullptr)
+	if (FragmentClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Return cached result if already searched
+
+	const UClass* Class{ FragmentClass };
+
+	if (const auto* CachedFragment{ FragmentClassCache.Find(Class) })
 	{
-		for (const auto& Fragment : Fragments)
+		return *CachedFragment;
+	}
+
+	// Search and cache result
+
+	const UEquipmentFragmentBase* FoundFragment{ nullptr };
+
+	for (const auto& Fragment : Fragments)
+	{
+		if (Fragment && Fragment->IsA(Class))
 		{
-			if (Fragment && Fragment->IsA(FragmentClass))
-			{
-				return Fragment;
-			}
+			FoundFragment = Fragment;
+			break;
+		}
+	}
+
+	FragmentClassCache.Add(Class, FoundFragment);
+
+	return FoundFragment;
+}
+
+void UEquipmentData::InvalidateFragmentClassCache()
+{
+	FragmentClassCache.Reset();
+}
+
+
+void UEquipmentData::BuildPhaseFragments() const
+{
+	EquipedFragments.Reset();
+	UnequipedFragments.Reset();
+	ActivatedFragments.Reset();
+	DeactivatedFragments.Reset();
+
+	for (const auto& Fragment : Fragments)
+	{
+		if (!Fragment)
+		{
+			continue;
+		}
+
+		const auto Phases{ Fragment->GetHandledPhases() };
+
+		if (EnumHasAnyFlags(Phases, EEquipmentFragmentPhase::Equiped))
+		{
+			EquipedFragments.Add(Fragment);
+		}
+
+		if (EnumHasAnyFlags(Phases, EEquipmentFragmentPhase::Unequiped))
+		{
+			UnequipedFragments.Add(Fragment);
+		}
+
+		if (EnumHasAnyFlags(Phases, EEquipmentFragmentPhase::Activated))
+		{
+			ActivatedFragments.Add(Fragment);
+		}
+
+		if (EnumHasAnyFlags(Phases, EEquipmentFragmentPhase::Deactivated))
+		{
+			DeactivatedFragments.Add(Fragment);
 		}
 	}
 
-	return nullptr;
+	bPhaseFragmentsBuilt = true;
+}
+
+void UEquipmentData::InvalidatePhaseFragments()
+{
+	bPhaseFragmentsBuilt = false;
+}
+
+const TArray<const UEquipmentFragmentBase*>& UEquipmentData::GetPhaseFragments(EEquipmentFragmentPhase Phase) const
+{
+	if (!bPhaseFragmentsBuilt)
+	{
+		BuildPhaseFragments();
+	}
+
+	switch (Phase)
+	{
+	case EEquipmentFragmentPhase::Equiped:
+		return EquipedFragments;
+
+	case EEquipmentFragmentPhase::Unequiped:
+		return UnequipedFragments;
+
+	case EEquipmentFragmentPhase::Activated:
+		return ActivatedFragments;
+
+	case EEquipmentFragmentPhase::Deactivated:
+		return DeactivatedFragments;
+
+	default:
+		checkNoEntry();
+		return EquipedFragments;
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -9,9 +9,27 @@
 #include "EquipmentData.generated.h"
 
 class UEquipmentFragmentBase;
+enum class EEquipmentFragmentPhase : uint8;
 class UEquipmentInstance;
 
 
+/**
+ * To which connections the EquipmentInstance is replicated
+ */
+UENUM(BlueprintType)
+enum class EEquipmentReplicationPolicy : uint8
+{
+	// Replicate to all connections
+	AllToEveryone,
+
+	// Replicate to all connections only while activated, otherwise only to the owner
+	ActiveToEveryone,
+
+	// Replicate only to the owner
+	OwnerOnly
+};
+
+
 /**
  * Class that defines predefined basic information such as the name and details of Equipment
  */
@@ -21,15 +39,24 @@ class GAEADDON_API UEquipmentData : public UPrimaryDataAsset
 	GENERATED_BODY()
 public:
 	UEquipmentData() {}
+
+	virtual void PostLoad() override;
 	
 #if WITH_EDITOR 
 	virtual EDataValidationResult IsDataValid(TArray<FText>& ValidationErrors) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif // WITH_EDITOR
 	
 #if WITH_EDITORONLY_DATA
 	virtual void UpdateAssetBundleData() override;
 #endif // WITH_EDITORONLY_DATA
 
+public:
+	//
+	// Name of the asset bundle containing assets needed while the Equipment is active
+	//
+	static const FName NAME_EquipmentBundle;
+
 public:
 	//
 	// Name displayed in game
@@ -67,12 +94,30 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Assignment")
 	TSubclassOf<UEquipmentInstance> InstanceType{ nullptr };
 
+	//
+	// To which connections the instance of this Equipment is replicated
+	// 
+	// Tips:
+	//	Can be overridden for each slot by SlotReplicationPolicies of EquipmentManagerComponent.
+	// 
+	// Note:
+	//	Clients that do not receive the instance do not execute the fragments of this Equipment (e.g. meshes are not spawned).
+	//
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication")
+	EEquipmentReplicationPolicy ReplicationPolicy{ EEquipmentReplicationPolicy::AllToEveryone };
+
 	//
 	// List of additional information about Equipment
 	//
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Instanced, Category = "Fragments")
 	TArray<TObjectPtr<UEquipmentFragmentBase>> Fragments;
 
+public:
+	/**
+	 * Returns whether this Equipment can be added to the specified slot
+	 */
+	bool IsSlotAllowed(FGameplayTag SlotTag) const;
+
 public:
 	/**
 	 * Executed when Equipment is Equiped
@@ -94,6 +139,12 @@ public:
 	 */
 	void HandleDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const;
 
+	/**
+	 * Executed when the asset bundle of Equipment is loaded while it is Activated.
+	 * Executes OnActivated of the fragments that were skipped by HandleActivated because they require the bundle.
+	 */
+	void HandleDeferredActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const;
+
 
 public:
 	/**
@@ -107,4 +158,39 @@ public:
 		return Cast<T>(FindFragmentByClass(T::StaticClass()));
 	}
 
+protected:
+	//
+	// Result of FindFragmentByClass for each requested class
+	// 
+	// Tips:
+	//	Built lazily on lookup. Classes without a matching fragment are also cached as nullptr.
+	// 
+	// Note:
+	//	Fragments are kept alive by the Fragments array, so this is not a UPROPERTY.
+	//
+	mutable TMap<const UClass*, const UEquipmentFragmentBase*> FragmentClassCache;
+
+protected:
+	void InvalidateFragmentClassCache();
+
+protected:
+	//
+	// Fragments to be executed in each phase
+	// 
+	// Tips:
+	//	Built in PostLoad from GetHandledPhases() of each fragment, or lazily if not yet built.
+	//
+	mutable TArray<const UEquipmentFragmentBase*> EquipedFragments;
+	mutable TArray<const UEquipmentFragmentBase*> UnequipedFragments;
+	mutable TArray<const UEquipmentFragmentBase*> ActivatedFragments;
+	mutable TArray<const UEquipmentFragmentBase*> DeactivatedFragments;
+
+	mutable bool bPhaseFragmentsBuilt{ false };
+
+protected:
+	void BuildPhaseFragments() const;
+	void InvalidatePhaseFragments();
+
+	const TArray<const UEquipmentFragmentBase*>& GetPhaseFragments(EEquipmentFragmentPhase Phase) const;
+
 };
@@ -3,11 +3,14 @@
 #include "EquipmentInstance.h"
 
 #include "EquipmentData.h"
+#include "EquipmentManagerComponent.h"
 #include "GAEAddonLogs.h"
+#include "GAEAddonStats.h"
 
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 #if UE_WITH_IRIS
 #include "Iris/ReplicationSystem/ReplicationFragmentUtil.h"
@@ -16,6 +19,45 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentInstance)
 
 
+void FEquipmentMeshToSpawn::PostSerialize(const FArchive& Ar)
+{
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	if (MeshToSpawn)
+	{
+		if (Mesh.IsNull())
+		{
+			Mesh = MeshToSpawn;
+		}
+
+		MeshToSpawn = nullptr;
+	}
+
+	if (MeshAnimInstance)
+	{
+		if (AnimClass.IsNull())
+		{
+			AnimClass = MeshAnimInstance.Get();
+		}
+
+		MeshAnimInstance = nullptr;
+	}
+}
+
+USkeletalMesh* FEquipmentMeshToSpawn::LoadMesh() const
+{
+	return MeshToSpawn ? MeshToSpawn.Get() : Mesh.LoadSynchronous();
+}
+
+TSubclassOf<UAnimInstance> FEquipmentMeshToSpawn::LoadAnimClass() const
+{
+	return MeshAnimInstance ? MeshAnimInstance : TSubclassOf<UAnimInstance>(AnimClass.LoadSynchronous());
+}
+
+
 UEquipmentInstance::UEquipmentInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, StatTags(this)
@@ -26,7 +68,10 @@ void UEquipmentInstance::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ThisClass, StatTags);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, StatTags, Params);
 }
 
 #if UE_WITH_IRIS
@@ -54,6 +99,8 @@ void UEquipmentInstance::OnEquiped(UEquipmentManagerComponent* EMC, const UEquip
 {
 	check(InEquipmentData);
 
+	OwnerComponent = EMC;
+
 	InEquipmentData->HandleEquiped(EMC, this);
 }
 
@@ -62,6 +109,18 @@ void UEquipmentInstance::OnUnequiped(UEquipmentManagerComponent* EMC, const UEqu
 	check(InEquipmentData);
 
 	InEquipmentData->HandleUnequiped(EMC, this);
+
+	// Abilities granted on activation must not outlive the Equipment
+
+	if (!ensureMsgf(!bHasActiveGrants, TEXT("%s was unequiped with abilities granted on activation still held."), *GetNameSafe(this)))
+	{
+		if (auto* ASC{ EMC ? EMC->GetAbilitySystemComponent() : nullptr })
+		{
+			RemoveAbilities_Active(ASC);
+		}
+	}
+
+	OwnerComponent = nullptr;
 }
 
 void UEquipmentInstance::OnActivated(UEquipmentManagerComponent* EMC, const UEquipmentData* InEquipmentData)
@@ -78,9 +137,47 @@ void UEquipmentInstance::OnDeactivated(UEquipmentManagerComponent* EMC, const UE
 	InEquipmentData->HandleDeactivated(EMC, this);
 }
 
+void UEquipmentInstance::ResetForReuse()
+{
+	// Clear StatTags while keeping replication IDs and keys increasing from the previous use
+
+	const auto IDCounter{ StatTags.IDCounter };
+	const auto ArrayReplicationKey{ StatTags.ArrayReplicationKey };
+
+	StatTags = FGameplayTagStackContainer(this);
+	StatTags.IDCounter = IDCounter;
+	StatTags.ArrayReplicationKey = ArrayReplicationKey;
+	StatTags.MarkArrayDirty();
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, StatTags, this);
+
+	// Granted abilities have already been taken from the ASC when unequiped
+
+	GrantedHandles_Equip = FAbilitySet_GrantedHandles();
+	GrantedHandles_Active = FAbilitySet_GrantedHandles();
+	TemplateGrantedHandles_Equip = FEquipmentTemplateGrantedHandles();
+	TemplateGrantedHandles_Active = FEquipmentTemplateGrantedHandles();
+	bHasActiveGrants = false;
+
+	RemoveAnimLayers();
+	DestroyEquipmentMeshes();
+}
+
+
+FGameplayTagStackContainer* UEquipmentInstance::GetStatTags()
+{
+	// StatTags are about to be changed
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, StatTags, this);
+
+	return &StatTags;
+}
+
 
 void UEquipmentInstance::SpawnEquipmentMeshes(USkeletalMeshComponent* TargetMesh, const TArray<FEquipmentMeshToSpawn>& InMeshesToSpawn)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("SpawnEquipmentMeshes", STAT_GAEA_SpawnEquipmentMeshes);
+
 	if (InMeshesToSpawn.IsEmpty())
 	{
 		return;
@@ -95,24 +192,44 @@ void UEquipmentInstance::SpawnEquipmentMeshes(USkeletalMeshComponent* TargetMesh
 	const auto bHiddenInGame{ static_cast<bool>(TargetMesh->bHiddenInGame) };
 	const auto bCastShadow{ static_cast<bool>(TargetMesh->CastShadow) };
 
-	UE_LOG(LogGAEA, Log, TEXT("[%s] Create Equipment Meshes for %s"),
+	GAEALIFECYCLELOG(this, TEXT("[%s] Create Equipment Meshes for %s"),
 		(GetWorld()->GetNetMode() == ENetMode::NM_Client) ? TEXT("CLIENT") : TEXT("SERVER"),
 		*GetNameSafe(TargetMesh));
 
+	auto* EMC{ OwnerComponent.Get() };
+
 	for (const auto& SpawnInfo : InMeshesToSpawn)
 	{
-		if (SpawnInfo.MeshToSpawn)
+		// Already loaded if the asset bundle has been preloaded
+
+		auto* SkeletalMesh{ SpawnInfo.LoadMesh() };
+		auto AnimClass{ SpawnInfo.LoadAnimClass() };
+
+		if (SkeletalMesh)
 		{
-			USkeletalMeshComponent* NewMesh = NewObject<USkeletalMeshComponent>(TargetMesh->GetOwner());
-			NewMesh->SetSkeletalMesh(SpawnInfo.MeshToSpawn);
-			NewMesh->SetAnimInstanceClass(SpawnInfo.MeshAnimInstance);
+			// Reuse a cached mesh if possible
+
+			auto* NewMesh{ EMC ? EMC->AcquireEquipmentMesh(SpawnInfo, TargetMesh->GetOwner()) : nullptr };
+			const auto bReused{ NewMesh != nullptr };
+
+			if (!bReused)
+			{
+				NewMesh = NewObject<USkeletalMeshComponent>(TargetMesh->GetOwner());
+				NewMesh->SetSkeletalMesh(SkeletalMesh);
+				NewMesh->SetAnimInstanceClass(AnimClass);
+			}
+
 			NewMesh->SetRelativeTransform(SpawnInfo.AttachTransform);
 			NewMesh->AttachToComponent(TargetMesh, FAttachmentTransformRules::KeepRelativeTransform, SpawnInfo.AttachSocket);
 			NewMesh->SetOwnerNoSee(bOwnerNoSee);
 			NewMesh->SetOnlyOwnerSee(bOnlyOwnerSee);
 			NewMesh->SetHiddenInGame(bHiddenInGame);
 			NewMesh->SetCastShadow(bCastShadow);
-			NewMesh->RegisterComponent();
+
+			if (!bReused)
+			{
+				NewMesh->RegisterComponent();
+			}
 
 			SpawnedMeshes.Add(NewMesh);
 		}
@@ -121,10 +238,21 @@ void UEquipmentInstance::SpawnEquipmentMeshes(USkeletalMeshComponent* TargetMesh
 
 void UEquipmentInstance::DestroyEquipmentMeshes()
 {
+	GAEA_SCOPE_CYCLE_COUNTER("DestroyEquipmentMeshes", STAT_GAEA_DestroyEquipmentMeshes);
+
+	auto* EMC{ OwnerComponent.Get() };
+
 	for (const auto& Mesh : SpawnedMeshes)
 	{
 		if (Mesh)
 		{
+			// Keep the mesh for reuse if possible
+
+			if (EMC && EMC->ReleaseEquipmentMesh(Mesh))
+			{
+				continue;
+			}
+
 			Mesh->DestroyComponent();
 		}
 	}
@@ -160,6 +288,8 @@ void UEquipmentInstance::GrantAbilitySet_Equip(const TArray<FAbilitySet_Gameplay
 void UEquipmentInstance::GrantAbilitySet_Active(const UAbilitySet* AbillitySet, UAbilitySystemComponent* ASC)
 {
 	GrantAbilitySet(AbillitySet, ASC, GrantedHandles_Active);
+
+	bHasActiveGrants = true;
 }
 
 void UEquipmentInstance::GrantAbilitySet_Active(const TArray<FAbilitySet_GameplayAbility>& Abilities, const TArray<FAbilitySet_GameplayEffect>& Effects, const TArray<FAbilitySet_AttributeSet>& Sets, UAbilitySystemComponent* ASC)
@@ -178,6 +308,25 @@ void UEquipmentInstance::GrantAbilitySet_Active(const TArray<FAbilitySet_Gamepla
 	{
 		GrantedHandles_Active.AddAttributeSets(ASC, Sets, this);
 	}
+
+	bHasActiveGrants |= (!Abilities.IsEmpty() || !Effects.IsEmpty() || !Sets.IsEmpty());
+}
+
+
+void UEquipmentInstance::GrantTemplate_Equip(const FEquipmentGrantTemplate& Template, UAbilitySystemComponent* ASC)
+{
+	check(ASC);
+
+	Template.GrantTo(ASC, this, TemplateGrantedHandles_Equip);
+}
+
+void UEquipmentInstance::GrantTemplate_Active(const FEquipmentGrantTemplate& Template, UAbilitySystemComponent* ASC)
+{
+	check(ASC);
+
+	Template.GrantTo(ASC, this, TemplateGrantedHandles_Active);
+
+	bHasActiveGrants |= !TemplateGrantedHandles_Active.IsEmpty();
 }
 
 
@@ -193,16 +342,22 @@ void UEquipmentInstance::GrantAbilitySet(const UAbilitySet* AbillitySet, UAbilit
 void UEquipmentInstance::RemoveAbilities_Equip(UAbilitySystemComponent* ASC)
 {
 	GrantedHandles_Equip.TakeFromAbilitySystem(ASC);
+	TemplateGrantedHandles_Equip.TakeFromAbilitySystem(ASC);
 }
 
 void UEquipmentInstance::RemoveAbilities_Active(UAbilitySystemComponent* ASC)
 {
 	GrantedHandles_Active.TakeFromAbilitySystem(ASC);
+	TemplateGrantedHandles_Active.TakeFromAbilitySystem(ASC);
+
+	bHasActiveGrants = false;
 }
 
 
 void UEquipmentInstance::ApplyAnimLayer(USkeletalMeshComponent* TargetMesh, TSubclassOf<UAnimInstance> InLayer)
 {
+	GAEA_SCOPE_CYCLE_COUNTER("ApplyAnimLayer", STAT_GAEA_ApplyAnimLayer);
+
 	check(TargetMesh);
 
 	if (InLayer)
@@ -226,6 +381,8 @@ void UEquipmentInstance::ApplyAnimLayer(USkeletalMeshComponent* TargetMesh, TSub
 
 void UEquipmentInstance::RemoveAnimLayers()
 {
+	GAEA_SCOPE_CYCLE_COUNTER("RemoveAnimLayers", STAT_GAEA_RemoveAnimLayers);
+
 	for (const auto& Handle : ApplyingAnimLayers)
 	{
 		if (Handle.MeshComponent.IsValid())
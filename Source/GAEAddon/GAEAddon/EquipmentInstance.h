@@ -5,6 +5,8 @@
 #include "GameplayTag/GameplayTagStack.h"
 #include "GameplayTag/GameplayTagStackInterface.h"
 
+#include "Grant/EquipmentGrantTemplate.h"
+
 #include "AbilitySet.h"
 
 #include "EquipmentInstance.generated.h"
@@ -49,11 +51,18 @@ public:
 	FEquipmentMeshToSpawn() {}
 
 public:
-	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	TObjectPtr<USkeletalMesh> MeshToSpawn;
+	//
+	// Mesh to spawn
+	// 
+	// Tips:
+	//	Loaded with the "Equipment" asset bundle when bPreloadEquipmentBundles of EquipmentManagerComponent is enabled.
+	//	Otherwise it is loaded synchronously when the mesh is spawned.
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (AssetBundles = "Equipment"))
+	TSoftObjectPtr<USkeletalMesh> Mesh;
 
-	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	TSubclassOf<UAnimInstance> MeshAnimInstance;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (AssetBundles = "Equipment"))
+	TSoftClassPtr<UAnimInstance> AnimClass;
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FName AttachSocket;
@@ -61,6 +70,47 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FTransform AttachTransform;
 
+	//
+	// Hard reference to the mesh to spawn, replaced by Mesh
+	// 
+	// Note:
+	//	Kept so that existing Blueprints and saved data keep working. Saved values are moved into Mesh on load,
+	//	but they are still loaded with the asset until it is resaved.
+	//
+	UPROPERTY(BlueprintReadWrite, meta = (DeprecatedProperty, DeprecationMessage = "Use Mesh, which is loaded with the Equipment asset bundle."))
+	TObjectPtr<USkeletalMesh> MeshToSpawn{ nullptr };
+
+	//
+	// Hard reference to the anim instance class, replaced by AnimClass
+	// 
+	// Note:
+	//	Kept so that existing Blueprints and saved data keep working. Saved values are moved into AnimClass on load.
+	//
+	UPROPERTY(BlueprintReadWrite, meta = (DeprecatedProperty, DeprecationMessage = "Use AnimClass, which is loaded with the Equipment asset bundle."))
+	TSubclassOf<UAnimInstance> MeshAnimInstance{ nullptr };
+
+public:
+	/**
+	 * Moves the deprecated hard references into the soft references
+	 */
+	void PostSerialize(const FArchive& Ar);
+
+	/**
+	 * Returns the mesh to spawn, preferring a deprecated hard reference set at runtime. Loaded synchronously if not loaded yet.
+	 */
+	USkeletalMesh* LoadMesh() const;
+
+	/**
+	 * Returns the anim instance class, preferring a deprecated hard reference set at runtime. Loaded synchronously if not loaded yet.
+	 */
+	TSubclassOf<UAnimInstance> LoadAnimClass() const;
+
+};
+
+template<>
+struct TStructOpsTypeTraits<FEquipmentMeshToSpawn> : public TStructOpsTypeTraitsBase2<FEquipmentMeshToSpawn>
+{
+	enum { WithPostSerialize = true };
 };
 
 
@@ -88,6 +138,13 @@ public:
 	virtual UWorld* GetWorld() const override final;
 
 
+protected:
+	//
+	// EquipmentManagerComponent in which this Equipment is registered
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UEquipmentManagerComponent> OwnerComponent{ nullptr };
+
 public:
 	/**
 	 * Called when this Equipment is created by EquipmentManagerComponent.
@@ -111,13 +168,30 @@ public:
 	 */
 	virtual void OnDeactivated(UEquipmentManagerComponent* EMC, const UEquipmentData* InEquipmentData);
 
+	/**
+	 * Called when this Equipment is returned to the instance pool after it has been unequiped.
+	 * Clears the state left by the previous Equipment so that this instance can be reused.
+	 */
+	virtual void ResetForReuse();
+
 
 protected:
+	//
+	// Stacks of stat tags of this Equipment
+	// 
+	// Note:
+	//	Replicated with the push model, so it is only compared for replication after it has been marked dirty.
+	//	Every change goes through GetStatTags, which marks it dirty. Requires net.IsPushModelEnabled, otherwise it is compared every update.
+	//
 	UPROPERTY(Replicated)
 	FGameplayTagStackContainer StatTags;
 
 protected:
-	virtual FGameplayTagStackContainer* GetStatTags() override { return &StatTags; }
+	/**
+	 * Returns StatTags to be changed by the setters of IGameplayTagStackInterface.
+	 * Marks StatTags dirty for replication, since every change to StatTags goes through here.
+	 */
+	virtual FGameplayTagStackContainer* GetStatTags() override;
 	virtual const FGameplayTagStackContainer* GetStatTagsConst() const override { return &StatTags; }
 
 
@@ -156,6 +230,30 @@ protected:
 	//
 	FAbilitySet_GrantedHandles GrantedHandles_Active;
 
+	//
+	// Handles of grants cloned from the fragment's FEquipmentGrantTemplate when registered to EquipmentManagerComponent
+	// 
+	// Note:
+	//	Only server privileges retain data
+	//
+	FEquipmentTemplateGrantedHandles TemplateGrantedHandles_Equip;
+
+	//
+	// Handles of grants cloned from the fragment's FEquipmentGrantTemplate when it is made Active in EquipmentManagerComponent.
+	// 
+	// Note:
+	//	Only server privileges retain data
+	//
+	FEquipmentTemplateGrantedHandles TemplateGrantedHandles_Active;
+
+	//
+	// Whether anything is held in GrantedHandles_Active or TemplateGrantedHandles_Active
+	// 
+	// Note:
+	//	Must be false when unequiped, since everything granted on activation is removed on deactivation.
+	//
+	bool bHasActiveGrants{ false };
+
 public:
 	/**
 	 * Apply AbilitySet granted at Equip time
@@ -177,6 +275,16 @@ public:
 		, const TArray<FAbilitySet_AttributeSet>& Sets
 		, UAbilitySystemComponent* ASC);
 
+	/**
+	 * Apply grants cloned from the template at Equip time
+	 */
+	virtual void GrantTemplate_Equip(const FEquipmentGrantTemplate& Template, UAbilitySystemComponent* ASC);
+
+	/**
+	 * Apply grants cloned from the template at Activate time
+	 */
+	virtual void GrantTemplate_Active(const FEquipmentGrantTemplate& Template, UAbilitySystemComponent* ASC);
+
 	/**
 	 * Apply AbilitySet
 	 */
@@ -192,6 +300,8 @@ public:
 	 */
 	virtual void RemoveAbilities_Active(UAbilitySystemComponent* ASC);
 
+	bool HasActiveGrants() const { return bHasActiveGrants; }
+
 
 protected:
 	//
@@ -219,6 +329,8 @@ protected:
 
 
 public:
+	UEquipmentManagerComponent* GetOwnerComponent() const { return OwnerComponent.Get(); }
+
 	template<typename T = APawn>
 	T* GetPawn() const
 	{
@@ -5,14 +5,23 @@
 #include "EquipmentSet.h"
 #include "EquipmentData.h"
 #include "EquipmentInstance.h"
+#include "Pool/EquipmentInstancePoolSubsystem.h"
+#include "Grant/EquipmentGrantQueueSubsystem.h"
 #include "GAEAddonLogs.h"
+#include "GAEAddonStats.h"
 
 #include "InitState/InitStateTags.h"
+#include "Character/CharacterMeshAccessorInterface.h"
 
 #include "GAEAbilitySystemComponent.h"
 
 #include "AbilitySystemGlobals.h"
+#include "GameplayEffectAggregator.h"
+#include "Engine/AssetManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
 #include "Engine/ActorChannel.h"
+#include "TimerManager.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "Net/UnrealNetwork.h"
 
@@ -29,6 +38,12 @@ UEquipmentManagerComponent::UEquipmentManagerComponent(const FObjectInitializer&
 	PrimaryComponentTick.bCanEverTick = false;
 
 	SetIsReplicatedByDefault(true);
+
+	// EquipmentInstances are replicated through the registered subobject list with their net condition
+
+	bReplicateUsingRegisteredSubObjectList = true;
+
+	PreloadBundleNames.Add(UEquipmentData::NAME_EquipmentBundle);
 }
 
 void UEquipmentManagerComponent::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
@@ -37,6 +52,7 @@ void UEquipmentManagerComponent::GetLifetimeReplicatedProps(TArray< FLifetimePro
 
 	DOREPLIFETIME(ThisClass, EquipmentContainer);
 	DOREPLIFETIME(ThisClass, InitialEquipmentSet);
+	DOREPLIFETIME(ThisClass, ReplicatedActiveSlotTag);
 }
 
 
@@ -44,6 +60,55 @@ void UEquipmentManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReaso
 {
 	UninitializeFromAbilitySystem();
 
+	// Pooled instances cannot be reused after the owner is gone
+
+	if (auto* World{ GetWorld() })
+	{
+		if (auto* InstancePool{ World->GetSubsystem<UEquipmentInstancePoolSubsystem>() })
+		{
+			InstancePool->DiscardInstancesOwnedBy(GetOwner());
+		}
+
+		if (bInitialEquipmentSetQueued)
+		{
+			if (auto* GrantQueue{ World->GetSubsystem<UEquipmentGrantQueueSubsystem>() })
+			{
+				GrantQueue->DequeueComponent(this);
+			}
+
+			bInitialEquipmentSetQueued = false;
+		}
+	}
+
+	MeshCache.Empty();
+
+	InvalidateMeshByTagCache();
+
+	// Cancelling calls back into HandleEquipmentPreloadCancelled, so take the handles out first
+
+	const auto Preloads{ MoveTemp(PendingPreloads) };
+
+	PendingPreloads.Empty();
+	PendingActivationSlotTags.Empty();
+
+	for (const auto& KVP : Preloads)
+	{
+		if (KVP.Value.IsValid())
+		{
+			KVP.Value->CancelHandle();
+		}
+	}
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(DeferredMessageFlushHandle);
+	DeferredMessageFlushHandle.Reset();
+
+	SlotListeners.Empty();
+
+	if (auto* World{ GetWorld() })
+	{
+		World->GetTimerManager().ClearTimer(ActiveSlotPredictionTimerHandle);
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -117,19 +182,66 @@ void UEquipmentManagerComponent::HandleChangeInitStateToDataInitialized(UGameFra
 {
 	InitializeWithAbilitySystem();
 
+	// Spread the initial grants of many pawns spawned in the same frame across frames
+
+	if (HasAuthority() && AbilitySystemComponent && UEquipmentGrantQueueSubsystem::EnqueueComponentFor(this))
+	{
+		bInitialEquipmentSetQueued = true;
+		return;
+	}
+
 	ApplyInitialEquipmentSet();
 }
 
+bool UEquipmentManagerComponent::CanChangeInitStateToGameplayReady(UGameFrameworkComponentManager* Manager) const
+{
+	// Wait for the initial equipment set to be applied from the grant queue
+
+	if (bInitialEquipmentSetQueued)
+	{
+		return false;
+	}
+
+	return Super::CanChangeInitStateToGameplayReady(Manager);
+}
+
 
 #pragma region Equipment Container
 
 bool UEquipmentManagerComponent::ReplicateSubobjects(UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags)
 {
+	// Instances are replicated with their net condition by the registered subobject list
+
+	if (IsUsingRegisteredSubObjectList())
+	{
+		return Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+	}
+
 	auto bWroteSomething{ Super::ReplicateSubobjects(Channel, Bunch, RepFlags) };
 
 	for (auto& Entry : EquipmentContainer.Entries)
 	{
-		if (auto Instance{ Entry.Instance })
+		auto* Instance{ Entry.Instance.Get() };
+		if (!Instance)
+		{
+			continue;
+		}
+
+		// Apply the same net condition as the registered subobject list
+
+		auto bShouldReplicate{ true };
+
+		switch (GetInstanceNetCondition(Entry))
+		{
+		case COND_OwnerOnly:
+			bShouldReplicate = RepFlags->bNetOwner;
+			break;
+
+		default:
+			break;
+		}
+
+		if (bShouldReplicate)
 		{
 			bWroteSomething |= Channel->ReplicateSubobject(Instance, *Bunch, *RepFlags);
 		}
@@ -142,16 +254,11 @@ void UEquipmentManagerComponent::ReadyForReplication()
 {
 	Super::ReadyForReplication();
 
-	if (IsUsingRegisteredSubObjectList())
+	for (auto& Entry : EquipmentContainer.Entries)
 	{
-		for (const auto& Entry : EquipmentContainer.Entries)
+		if (IsValid(Entry.Instance))
 		{
-			auto Instance{ Entry.Instance };
-
-			if (IsValid(Instance))
-			{
-				AddReplicatedSubObject(Instance);
-			}
+			AddReplicatedEquipmentInstance(Entry);
 		}
 	}
 }
@@ -159,277 +266,802 @@ void UEquipmentManagerComponent::ReadyForReplication()
 #pragma endregion
 
 
-#pragma region Initial Equipments
+#pragma region Active Slot Replication
 
-void UEquipmentManagerComponent::OnRep_InitialEquipmentSet()
+EEquipmentReplicationPolicy UEquipmentManagerComponent::GetReplicationPolicy(const FEquipmentEntry& Entry) const
 {
-	check(InitialEquipmentSet);
+	if (const auto* SlotPolicy{ SlotReplicationPolicies.Find(Entry.SlotTag) })
+	{
+		return *SlotPolicy;
+	}
 
-	CheckDefaultInitialization();
+	return Entry.Data ? Entry.Data->ReplicationPolicy : EEquipmentReplicationPolicy::AllToEveryone;
 }
 
-void UEquipmentManagerComponent::ApplyInitialEquipmentSet()
+ELifetimeCondition UEquipmentManagerComponent::GetInstanceNetCondition(const FEquipmentEntry& Entry) const
 {
-	// Must have Authority
+	auto NetCondition{ COND_None };
 
-	if (!HasAuthority())
+	switch (GetReplicationPolicy(Entry))
 	{
-		return;
-	}
-
-	check(AbilitySystemComponent);
-	check(InitialEquipmentSet);
+	case EEquipmentReplicationPolicy::ActiveToEveryone:
+		NetCondition = Entry.Activated ? COND_None : COND_OwnerOnly;
+		break;
 
-	// Add Equipments to the specified slots
+	case EEquipmentReplicationPolicy::OwnerOnly:
+		NetCondition = COND_OwnerOnly;
+		break;
 
-	for (const auto& Entry : InitialEquipmentSet->Entries)
-	{
-		// Check if the argument is valid
+	default:
+		break;
+	}
 
-		if (!Entry.EquipmentData || !Entry.SlotTag.IsValid())
-		{
-			continue;
-		}
+	return NetCondition;
+}
 
-		// Add Equipment to the specified slot
 
-		if (auto* Result{ EquipmentContainer.AddEntry(Entry.EquipmentData, Entry.SlotTag) })
-		{
-			if (IsUsingRegisteredSubObjectList() && IsReadyForReplication())
-			{
-				AddReplicatedSubObject(Result);
-			}
-		}
+void UEquipmentManagerComponent::OnRep_ReplicatedActiveSlotTag()
+{
+	if (bReplicateActiveSlotSeparately)
+	{
+		EquipmentContainer.ApplyReplicatedActiveSlot(ReplicatedActiveSlotTag);
 	}
+}
 
-	// Set new active slot
-
-	auto ActivateSlotTag{ InitialEquipmentSet->DefaultActiveSlotTag };
+#pragma endregion
 
-	// Cache new active slot indexes and last active slot indices
 
-	auto LastActiveIndex{ static_cast<int32>(INDEX_NONE) };
-	auto NewActiveIndex{ static_cast<int32>(INDEX_NONE) };
+#pragma region Deferred Slot Change Message
 
-	for (auto It{ EquipmentContainer.Entries.CreateIterator() }; It; ++It)
-	{
-		auto& Entry{ *It };
+void UEquipmentManagerComponent::FlushSlotChangeMessages()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(DeferredMessageFlushHandle);
+	DeferredMessageFlushHandle.Reset();
 
-		if (Entry.Activated)
-		{
-			LastActiveIndex = It.GetIndex();
-		}
+	EquipmentContainer.FlushPendingMessages();
+}
 
-		if (Entry.SlotTag == ActivateSlotTag)
-		{
-			NewActiveIndex = It.GetIndex();
-		}
+void UEquipmentManagerComponent::ScheduleSlotChangeMessageFlush()
+{
+	if (!DeferredMessageFlushHandle.IsValid())
+	{
+		DeferredMessageFlushHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
 	}
+}
 
-	// Check if the new active slot index is valid
-
-	if ((NewActiveIndex == INDEX_NONE) || (NewActiveIndex == LastActiveIndex))
+void UEquipmentManagerComponent::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
 	{
-		return;
+		FlushSlotChangeMessages();
 	}
+}
 
-	// Set active slot
+#pragma endregion
 
-	if (LastActiveIndex != INDEX_NONE)
-	{
-		EquipmentContainer.DeactivateEntry(LastActiveIndex);
-	}
 
-	EquipmentContainer.ActivateEntry(NewActiveIndex);
+#pragma region Slot Listener
+
+FDelegateHandle UEquipmentManagerComponent::RegisterSlotListener(
+	FGameplayTag SlotTag,
+	EEquipmentSlotMatch MatchType,
+	FEquipmentSlotListenerDelegate OnSlotChanged,
+	FEquipmentSlotListenerDelegate OnActiveSlotChanged)
+{
+	auto& NewListener{ SlotListeners.FindOrAdd(SlotTag).AddDefaulted_GetRef() };
+	NewListener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	NewListener.MatchType = MatchType;
+	NewListener.OnSlotChanged = MoveTemp(OnSlotChanged);
+	NewListener.OnActiveSlotChanged = MoveTemp(OnActiveSlotChanged);
+
+	return NewListener.Handle;
 }
 
-void UEquipmentManagerComponent::SetInitialEquipmentSet(const UEquipmentSet* NewEquipmentSet)
+void UEquipmentManagerComponent::UnregisterSlotListener(FDelegateHandle Handle)
 {
-	if (HasAuthority())
+	for (auto It{ SlotListeners.CreateIterator() }; It; ++It)
 	{
-		// If alread set, skip below
+		It->Value.RemoveAll([Handle](const FEquipmentSlotListener& Listener) { return Listener.Handle == Handle; });
 
-		if (InitialEquipmentSet)
+		if (It->Value.IsEmpty())
 		{
-			return;
+			It.RemoveCurrent();
 		}
+	}
+}
 
-		// Set Initial Equipment Set
+void UEquipmentManagerComponent::UnregisterSlotListeners(const void* UserObject)
+{
+	for (auto It{ SlotListeners.CreateIterator() }; It; ++It)
+	{
+		It->Value.RemoveAll(
+			[UserObject](const FEquipmentSlotListener& Listener)
+			{
+				return Listener.OnSlotChanged.IsBoundToObject(UserObject) || Listener.OnActiveSlotChanged.IsBoundToObject(UserObject);
+			});
 
-		if (InitialEquipmentSet != NewEquipmentSet)
+		if (It->Value.IsEmpty())
 		{
-			InitialEquipmentSet = NewEquipmentSet;
-
-			CheckDefaultInitialization();
+			It.RemoveCurrent();
 		}
 	}
 }
 
-#pragma endregion
-
-
-#pragma region Equipment Change
 
-void UEquipmentManagerComponent::ResetEquipments(const TArray<FEquipmentSetEntry>& Entries, FGameplayTag ActivateSlotTag)
+void UEquipmentManagerComponent::DispatchSlotChangeToListeners(const FEquipmentSlotChangedMessage& Message) const
 {
-	// Must have Authority
-
-	if (!GetOwner()->HasAuthority())
+	if (SlotListeners.IsEmpty())
 	{
 		return;
 	}
 
-	// If has not game ready, skip
+	// Copy delegates so that listeners can unregister during the dispatch
 
-	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	TArray<FEquipmentSlotListenerDelegate, TInlineAllocator<8>> Delegates;
+	GatherSlotListeners(Message.SlotTag, false, Delegates);
+
+	for (const auto& Delegate : Delegates)
 	{
-		return;
+		Delegate.ExecuteIfBound(Message);
 	}
+}
 
-	// If the specified slot already has Equipment, remove it.
+void UEquipmentManagerComponent::DispatchActiveSlotChangeToListeners(const FEquipmentSlotChangedMessage& Message)
+{
+	const auto PrevActiveSlotTag{ LastDispatchedActiveSlotTag };
+	LastDispatchedActiveSlotTag = Message.SlotTag;
 
-	auto Instances{ EquipmentContainer.RemoveAllEntries() };
-	for (const auto& Instance : Instances)
+	if (SlotListeners.IsEmpty())
 	{
-		if (IsUsingRegisteredSubObjectList())
-		{
-			RemoveReplicatedSubObject(Instance);
-		}
+		return;
 	}
 
-	Instances.Empty();
+	// Notify both the newly activated slot and the previously activated slot
 
+	TArray<FEquipmentSlotListenerDelegate, TInlineAllocator<8>> Delegates;
+	GatherSlotListeners(Message.SlotTag, true, Delegates);
 
-	// Add Equipments to the specified slots
+	if (PrevActiveSlotTag.IsValid() && (PrevActiveSlotTag != Message.SlotTag))
+	{
+		GatherSlotListeners(PrevActiveSlotTag, true, Delegates);
+	}
 
-	for (const auto& Entry : Entries)
+	for (const auto& Delegate : Delegates)
 	{
-		// Check if the argument is valid
+		Delegate.ExecuteIfBound(Message);
+	}
+}
 
-		if (!Entry.EquipmentData || !Entry.SlotTag.IsValid())
-		{
-			continue;
-		}
+void UEquipmentManagerComponent::GatherSlotListeners(FGameplayTag SlotTag, bool bActiveSlotChange, TArray<FEquipmentSlotListenerDelegate, TInlineAllocator<8>>& OutDelegates) const
+{
+	// Walk from the slot itself up to its parents
 
-		// Add Equipment to the specified slot
+	auto bExactSlot{ true };
 
-		if (auto* Result{ EquipmentContainer.AddEntry(Entry.EquipmentData, Entry.SlotTag) })
+	for (auto Tag{ SlotTag }; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	{
+		if (const auto* Listeners{ SlotListeners.Find(Tag) })
 		{
-			if (IsUsingRegisteredSubObjectList() && IsReadyForReplication())
+			for (const auto& Listener : *Listeners)
 			{
-				AddReplicatedSubObject(Result);
+				if (bExactSlot || (Listener.MatchType == EEquipmentSlotMatch::IncludeChildren))
+				{
+					const auto& Delegate{ bActiveSlotChange ? Listener.OnActiveSlotChanged : Listener.OnSlotChanged };
+
+					if (Delegate.IsBound())
+					{
+						OutDelegates.Add(Delegate);
+					}
+				}
 			}
 		}
-	}
 
-	// Set new active slot
-
-	if (ActivateSlotTag.IsValid())
-	{
-		SetActiveSlot(ActivateSlotTag);
+		bExactSlot = false;
 	}
 }
 
-void UEquipmentManagerComponent::ResetEquipmentsByEquipmentSet(const UEquipmentSet* InSet)
+#pragma endregion
+
+
+#pragma region Equipment Transaction
+
+void UEquipmentManagerComponent::BeginEquipmentTransaction()
 {
-	if (InSet)
+	// Must have Authority
+
+	if (!GetOwner()->HasAuthority())
 	{
-		ResetEquipments(InSet->Entries, InSet->DefaultActiveSlotTag);
+		return;
 	}
+
+	++TransactionDepth;
 }
 
-bool UEquipmentManagerComponent::AddEquipment(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, bool ActivateImmediately)
+void UEquipmentManagerComponent::CommitEquipmentTransaction()
 {
 	// Must have Authority
 
 	if (!GetOwner()->HasAuthority())
 	{
-		return false;
+		return;
 	}
 
-	// If has not game ready, skip
+	if (TransactionDepth <= 0)
+	{
+		UE_LOG(LogGAEA, Warning, TEXT("EquipmentManagerComponent: CommitEquipmentTransaction was called without BeginEquipmentTransaction on [%s]."), *GetNameSafe(GetOwner()));
+		return;
+	}
 
-	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	// Apply changes when the outermost transaction is committed
+
+	if (--TransactionDepth > 0)
 	{
-		return false;
+		return;
 	}
 
-	// Check if the argument is valid
+	const auto Transaction{ MoveTemp(PendingTransaction) };
+	PendingTransaction.Reset();
 
-	if (!EquipmentData || !SlotTag.IsValid())
+	ApplyEquipmentTransaction(Transaction);
+}
+
+void UEquipmentManagerComponent::ApplyEquipmentTransaction(const FEquipmentTransaction& Transaction)
+{
+	GAEA_SCOPE_CYCLE_COUNTER("ApplyEquipmentTransaction", STAT_GAEA_ApplyEquipmentTransaction);
+
+	if (Transaction.IsEmpty())
 	{
-		return false;
+		return;
 	}
 
-	// If the specified slot already has Equipment, remove it.
+	EquipmentContainer.BeginBatch();
+
+	// Remove all equipments registered before the transaction
 
-	if (auto* Instance{ EquipmentContainer.RemoveEntry(SlotTag) })
+	if (Transaction.bRemoveAll)
 	{
-		if (IsUsingRegisteredSubObjectList())
+		if (bKeepUnchangedEquipments)
 		{
-			RemoveReplicatedSubObject(Instance);
+			RemoveChangedEntries(Transaction);
+		}
+		else
+		{
+			auto Instances{ EquipmentContainer.RemoveAllEntries() };
+			for (const auto& Instance : Instances)
+			{
+				RemoveReplicatedEquipmentInstance(Instance);
+
+				UEquipmentInstancePoolSubsystem::ReleaseInstanceFor(Instance);
+			}
 		}
 	}
 
-	// Add Equipment to the specified slot
+	// Change Equipment in the specified slots
 
-	if (auto* Result{ EquipmentContainer.AddEntry(EquipmentData, SlotTag) })
+	for (const auto& KVP : Transaction.SlotChanges)
 	{
-		if (IsUsingRegisteredSubObjectList() && IsReadyForReplication())
+		const auto& SlotTag{ KVP.Key };
+		const auto& EquipmentData{ KVP.Value };
+
+		// Keep the Equipment if the slot already has the same one
+
+		if (bKeepUnchangedEquipments && EquipmentData)
 		{
-			AddReplicatedSubObject(Result);
+			const auto* Entry{ EquipmentContainer.FindEntry(SlotTag) };
+
+			if (Entry && (Entry->Data == EquipmentData))
+			{
+				continue;
+			}
 		}
 
-		if (ActivateImmediately == true)
+		// If the specified slot already has Equipment, remove it.
+
+		if (auto* Instance{ EquipmentContainer.RemoveEntry(SlotTag) })
 		{
-			SetActiveSlot(SlotTag);
+			RemoveReplicatedEquipmentInstance(Instance);
+
+			UEquipmentInstancePoolSubsystem::ReleaseInstanceFor(Instance);
 		}
 
-		return true;
-	}
+		// Add Equipment to the specified slot
 
-	return false;
-}
+		if (EquipmentData)
+		{
+			if (EquipmentContainer.AddEntry(EquipmentData, SlotTag))
+			{
+				AddReplicatedEquipmentInstance(EquipmentContainer.Entries[EquipmentContainer.FindEntryIndex(SlotTag)]);
+			}
+		}
+	}
 
-bool UEquipmentManagerComponent::RemoveEquipment(FGameplayTag SlotTag)
-{
-	// Must have Authority
+	// Set new active slot
 
-	if (!GetOwner()->HasAuthority())
+	if (Transaction.ActiveSlotTag.IsValid())
 	{
-		return false;
+		ApplyActiveSlot(Transaction.ActiveSlotTag);
 	}
 
-	// If has not game ready, skip
+	EquipmentContainer.EndBatch();
+}
 
-	if (!HasReachedInitState(TAG_InitState_GameplayReady))
-	{
-		return false;
-	}
+void UEquipmentManagerComponent::RemoveChangedEntries(const FEquipmentTransaction& Transaction)
+{
+	// Collect slots that will not have the same Equipment after the transaction
 
-	// Check if the argument is valid
+	TArray<FGameplayTag> RemovingSlotTags;
 
-	if (!SlotTag.IsValid())
+	for (const auto& Entry : EquipmentContainer.Entries)
 	{
-		return false;
-	}
+		const auto* NewEquipmentData{ Transaction.SlotChanges.Find(Entry.SlotTag) };
 
-	// Remove equipment from slot
+		if (!NewEquipmentData || (*NewEquipmentData != Entry.Data))
+		{
+			RemovingSlotTags.Add(Entry.SlotTag);
+		}
+	}
 
-	if (auto* Instance{ EquipmentContainer.RemoveEntry(SlotTag) })
+	for (const auto& SlotTag : RemovingSlotTags)
 	{
-		if (IsUsingRegisteredSubObjectList())
+		if (auto* Instance{ EquipmentContainer.RemoveEntry(SlotTag) })
 		{
-			RemoveReplicatedSubObject(Instance);
-		}
+			RemoveReplicatedEquipmentInstance(Instance);
 
-		return true;
+			UEquipmentInstancePoolSubsystem::ReleaseInstanceFor(Instance);
+		}
 	}
+
+	// Removing all Equipment also deactivates the active slot, so keep it only if it will be activated again
+
+	const auto ActiveIndex{ EquipmentContainer.GetActiveEntryIndex() };
+
+	if ((ActiveIndex != INDEX_NONE) && !Transaction.ActiveSlotTag.IsValid())
+	{
+		EquipmentContainer.DeactivateEntry(ActiveIndex);
+		RefreshReplicatedEquipmentInstance(EquipmentContainer.Entries[ActiveIndex]);
+	}
+}
+
+void UEquipmentManagerComponent::ApplyActiveSlot(FGameplayTag SlotTag)
+{
+	// Cache new active slot indexes and last active slot indices
+
+	const auto LastActiveIndex{ EquipmentContainer.GetActiveEntryIndex() };
+	const auto NewActiveIndex{ EquipmentContainer.FindEntryIndex(SlotTag) };
+
+	// Check if the new active slot index is valid
+
+	if ((NewActiveIndex == INDEX_NONE) || (NewActiveIndex == LastActiveIndex))
+	{
+		return;
+	}
+
+	// Set active slot
+
+	if (LastActiveIndex != INDEX_NONE)
+	{
+		EquipmentContainer.DeactivateEntry(LastActiveIndex);
+		RefreshReplicatedEquipmentInstance(EquipmentContainer.Entries[LastActiveIndex]);
+	}
+
+	EquipmentContainer.ActivateEntry(NewActiveIndex);
+	RefreshReplicatedEquipmentInstance(EquipmentContainer.Entries[NewActiveIndex]);
+}
+
+void UEquipmentManagerComponent::AddReplicatedEquipmentInstance(FEquipmentEntry& Entry)
+{
+	if (Entry.Instance && IsUsingRegisteredSubObjectList() && IsReadyForReplication())
+	{
+		Entry.RegisteredNetCondition = GetInstanceNetCondition(Entry);
+
+		AddReplicatedSubObject(Entry.Instance, Entry.RegisteredNetCondition);
+	}
+}
+
+void UEquipmentManagerComponent::RemoveReplicatedEquipmentInstance(UEquipmentInstance* Instance)
+{
+	if (Instance && IsUsingRegisteredSubObjectList())
+	{
+		RemoveReplicatedSubObject(Instance);
+	}
+}
+
+void UEquipmentManagerComponent::RefreshReplicatedEquipmentInstance(FEquipmentEntry& Entry)
+{
+	// Skip instances that have not been registered yet
+
+	if (!Entry.Instance || (Entry.RegisteredNetCondition == COND_Max))
+	{
+		return;
+	}
+
+	const auto NetCondition{ GetInstanceNetCondition(Entry) };
+
+	if (NetCondition != Entry.RegisteredNetCondition)
+	{
+		RemoveReplicatedSubObject(Entry.Instance);
+		AddReplicatedSubObject(Entry.Instance, NetCondition);
+
+		Entry.RegisteredNetCondition = NetCondition;
+	}
+}
+
+#pragma endregion
+
+
+#pragma region Initial Equipments
+
+void UEquipmentManagerComponent::OnRep_InitialEquipmentSet()
+{
+	check(InitialEquipmentSet);
+
+	CheckDefaultInitialization();
+}
+
+void UEquipmentManagerComponent::ApplyInitialEquipmentSet()
+{
+	// Must have Authority
+
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	check(AbilitySystemComponent);
+	check(InitialEquipmentSet);
+
+	// Aggregators modified by multiple effects are evaluated once after all Equipment is added
+
+	FScopedAggregatorOnDirtyBatch AggregatorBatch;
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	// Add Equipments to the specified slots
+
+	for (const auto& Entry : InitialEquipmentSet->Entries)
+	{
+		// Check if the argument is valid
+
+		if (!Entry.EquipmentData || !Entry.SlotTag.IsValid())
+		{
+			continue;
+		}
+
+		PendingTransaction.AddEquipment(Entry.SlotTag, Entry.EquipmentData);
+	}
+
+	// Set new active slot
+
+	if (InitialEquipmentSet->DefaultActiveSlotTag.IsValid())
+	{
+		PendingTransaction.SetActiveSlot(InitialEquipmentSet->DefaultActiveSlotTag);
+	}
+}
+
+void UEquipmentManagerComponent::ApplyQueuedInitialEquipmentSet()
+{
+	if (!bInitialEquipmentSetQueued)
+	{
+		return;
+	}
+
+	bInitialEquipmentSetQueued = false;
+
+	if (AbilitySystemComponent && InitialEquipmentSet)
+	{
+		ApplyInitialEquipmentSet();
+	}
+
+	CheckDefaultInitialization();
+}
+
+void UEquipmentManagerComponent::SetInitialEquipmentSet(const UEquipmentSet* NewEquipmentSet)
+{
+	if (HasAuthority())
+	{
+		// If alread set, skip below
+
+		if (InitialEquipmentSet)
+		{
+			return;
+		}
+
+		// Set Initial Equipment Set
+
+		if (InitialEquipmentSet != NewEquipmentSet)
+		{
+			InitialEquipmentSet = NewEquipmentSet;
+
+			CheckDefaultInitialization();
+		}
+	}
+}
+
+#pragma endregion
+
+
+#pragma region Equipment Change
+
+void UEquipmentManagerComponent::ResetEquipments(const TArray<FEquipmentSetEntry>& Entries, FGameplayTag ActivateSlotTag)
+{
+	// Must have Authority
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	// If has not game ready, skip
+
+	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	{
+		return;
+	}
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	// Remove all equipments
+
+	PendingTransaction.RemoveAllEquipments();
+
+	// Add Equipments to the specified slots
+
+	for (const auto& Entry : Entries)
+	{
+		// Check if the argument is valid
+
+		if (!Entry.EquipmentData || !Entry.SlotTag.IsValid())
+		{
+			continue;
+		}
+
+		PendingTransaction.AddEquipment(Entry.SlotTag, Entry.EquipmentData);
+	}
+
+	// Set new active slot
+
+	if (ActivateSlotTag.IsValid())
+	{
+		PendingTransaction.SetActiveSlot(ActivateSlotTag);
+	}
+}
+
+void UEquipmentManagerComponent::ResetEquipmentsByEquipmentSet(const UEquipmentSet* InSet)
+{
+	if (InSet)
+	{
+		ResetEquipments(InSet->Entries, InSet->DefaultActiveSlotTag);
+	}
+}
+
+bool UEquipmentManagerComponent::AddEquipment(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, bool ActivateImmediately)
+{
+	// Must have Authority
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return false;
+	}
+
+	// If has not game ready, skip
+
+	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	{
+		return false;
+	}
+
+	// Check if the argument is valid
+
+	if (!EquipmentData || !SlotTag.IsValid())
+	{
+		return false;
+	}
+
+	// Is it trying to add to the allowed slots?
+
+	if (!EquipmentData->IsSlotAllowed(SlotTag))
+	{
+		return false;
+	}
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	// Add Equipment to the specified slot
+	// The change has been validated, so it can no longer fail when the transaction is applied
+
+	PendingTransaction.AddEquipment(SlotTag, EquipmentData);
+
+	if (ActivateImmediately == true)
+	{
+		PendingTransaction.SetActiveSlot(SlotTag);
+	}
+
+	return true;
+}
+
+bool UEquipmentManagerComponent::RemoveEquipment(FGameplayTag SlotTag)
+{
+	// Must have Authority
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return false;
+	}
+
+	// If has not game ready, skip
+
+	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	{
+		return false;
+	}
+
+	// Check if the argument is valid
+
+	if (!SlotTag.IsValid())
+	{
+		return false;
+	}
+
+	// Check if the slot has Equipment, taking into account the changes in the transaction
+
+	const auto* PendingChange{ PendingTransaction.SlotChanges.Find(SlotTag) };
+
+	const auto bHasEquipment
+	{
+		PendingChange ? (*PendingChange != nullptr) : (!PendingTransaction.bRemoveAll && (EquipmentContainer.FindEntryIndex(SlotTag) != INDEX_NONE))
+	};
+
+	if (!bHasEquipment)
+	{
+		return false;
+	}
+
+	// Remove equipment from slot
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	PendingTransaction.RemoveEquipment(SlotTag);
 	
-	return false;
+	return true;
+}
+
+void UEquipmentManagerComponent::RemoveAllEquipments()
+{
+	// Must have Authority
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	// If has not game ready, skip
+
+	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	{
+		return;
+	}
+
+	// Remove equipments from slots
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	PendingTransaction.RemoveAllEquipments();
+}
+
+#pragma endregion
+
+
+#pragma region Equipment Request
+
+void UEquipmentManagerComponent::RequestEquipmentChanges(const TArray<FEquipmentSlotRequest>& Requests)
+{
+	if (Requests.IsEmpty())
+	{
+		return;
+	}
+
+	if (GetOwner()->HasAuthority())
+	{
+		ApplyEquipmentRequests(Requests, false);
+	}
+	else
+	{
+		ServerRequestEquipmentChanges(Requests);
+	}
+}
+
+void UEquipmentManagerComponent::ServerRequestEquipmentChanges_Implementation(const TArray<FEquipmentSlotRequest>& Requests)
+{
+	if (Requests.Num() > MaxRequestsPerBatch)
+	{
+		UE_LOG(LogGAEA, Warning, TEXT("Dropped %d equipment requests from %s: exceeds MaxRequestsPerBatch(%d)."), Requests.Num(), *GetNameSafe(GetOwner()), MaxRequestsPerBatch);
+		return;
+	}
+
+	ApplyEquipmentRequests(Requests, true);
+}
+
+void UEquipmentManagerComponent::ApplyEquipmentRequests(const TArray<FEquipmentSlotRequest>& Requests, bool bFromClient)
+{
+	// If has not game ready, skip
+
+	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	{
+		return;
+	}
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	for (const auto& Request : Requests)
+	{
+		// Consume a token for each request, including the ones rejected later
+
+		if (bFromClient && !ConsumeRequestToken())
+		{
+			UE_LOG(LogGAEA, Verbose, TEXT("Dropped equipment request for slot(%s) from %s: rate limit exceeded."), *Request.SlotTag.GetTagName().ToString(), *GetNameSafe(GetOwner()));
+			break;
+		}
+
+		// Requests made on the server are validated by AddEquipment, RemoveEquipment and SetActiveSlot themselves
+
+		if (bFromClient && !CanAcceptEquipmentRequest(Request))
+		{
+			UE_LOG(LogGAEA, Verbose, TEXT("Rejected equipment request for slot(%s) from %s."), *Request.SlotTag.GetTagName().ToString(), *GetNameSafe(GetOwner()));
+			continue;
+		}
+
+		switch (Request.Type)
+		{
+		case EEquipmentRequestType::Add:
+			AddEquipment(Request.SlotTag, Request.EquipmentData, false);
+			break;
+
+		case EEquipmentRequestType::Remove:
+			RemoveEquipment(Request.SlotTag);
+			break;
+
+		case EEquipmentRequestType::Activate:
+			SetActiveSlot(Request.SlotTag);
+			break;
+		}
+	}
+}
+
+bool UEquipmentManagerComponent::ConsumeRequestToken()
+{
+	RequestTokenBucket.Refill(GetWorld()->GetTimeSeconds(), RequestBurstCapacity, RequestsPerSecond);
+
+	return RequestTokenBucket.TryConsume();
+}
+
+bool UEquipmentManagerComponent::CanAcceptEquipmentRequest(const FEquipmentSlotRequest& Request) const
+{
+	if (!Request.SlotTag.IsValid())
+	{
+		return false;
+	}
+
+	// Is it trying to add to the allowed slots?
+
+	if (Request.Type == EEquipmentRequestType::Add)
+	{
+		return Request.EquipmentData && Request.EquipmentData->IsSlotAllowed(Request.SlotTag) && CanClientAddEquipment(Request.EquipmentData, Request.SlotTag);
+	}
+
+	return true;
 }
 
-void UEquipmentManagerComponent::RemoveAllEquipments()
+bool UEquipmentManagerComponent::CanClientAddEquipment(const UEquipmentData* EquipmentData, FGameplayTag SlotTag) const
+{
+	return ClientAddableEquipments.Contains(EquipmentData);
+}
+
+#pragma endregion
+
+
+#pragma region Active Slot
+
+void UEquipmentManagerComponent::SetActiveSlot(FGameplayTag SlotTag)
 {
 	// Must have Authority
 
@@ -445,100 +1077,211 @@ void UEquipmentManagerComponent::RemoveAllEquipments()
 		return;
 	}
 
-	// Remove equipments from slots
+	// Check if the argument is valid
 
-	auto Instances{ EquipmentContainer.RemoveAllEntries() };
-	for (const auto& Instance : Instances)
+	if (!SlotTag.IsValid())
 	{
-		if (IsUsingRegisteredSubObjectList())
-		{
-			RemoveReplicatedSubObject(Instance);
-		}
+		return;
 	}
 
-	Instances.Empty();
+	// Set active slot
+
+	FScopedEquipmentTransaction ScopedTransaction(this);
+
+	PendingTransaction.SetActiveSlot(SlotTag);
 }
 
-#pragma endregion
+void UEquipmentManagerComponent::SetActiveSlotPredicted(FGameplayTag SlotTag)
+{
+	// Server does not need to predict
 
+	if (GetOwner()->HasAuthority())
+	{
+		SetActiveSlot(SlotTag);
+		return;
+	}
 
-#pragma region Active Slot
+	// Only the locally controlled pawn can predict
 
-void UEquipmentManagerComponent::SetActiveSlot(FGameplayTag SlotTag)
-{
-	// Must have Authority
+	const auto* Pawn{ GetPawn<APawn>() };
 
-	if (!GetOwner()->HasAuthority())
+	if (!Pawn || !Pawn->IsLocallyControlled())
 	{
 		return;
 	}
 
 	// If has not game ready, skip
 
-	if (!HasReachedInitState(TAG_InitState_GameplayReady))
+	if (!HasReachedInitState(TAG_InitState_GameplayReady) || !AbilitySystemComponent)
 	{
 		return;
 	}
 
-	// Check if the argument is valid
+	// Check if the slot has Equipment and is not active yet
 
-	if (!SlotTag.IsValid())
+	const auto NewActiveIndex{ EquipmentContainer.FindEntryIndex(SlotTag) };
+
+	if ((NewActiveIndex == INDEX_NONE) || (NewActiveIndex == EquipmentContainer.GetActiveEntryIndex()))
 	{
 		return;
 	}
 
-	// Cache new active slot indexes and last active slot indices
+	// Generate new prediction key
+
+	FScopedPredictionWindow ScopedPrediction(AbilitySystemComponent, true);
+
+	auto PredictionKey{ AbilitySystemComponent->ScopedPredictionKey };
+
+	PredictedActiveSlotTag = SlotTag;
+	ActiveSlotPredictionKey = PredictionKey.Current;
+
+	PredictionKey.NewRejectedDelegate().BindUObject(this, &ThisClass::HandleActiveSlotPredictionRejected, PredictionKey.Current);
+	PredictionKey.NewCaughtUpDelegate().BindUObject(this, &ThisClass::HandleActiveSlotPredictionCaughtUp, PredictionKey.Current);
+
+	// Activate locally and request to server
+
+	EquipmentContainer.ApplyLocalActiveEntry(NewActiveIndex);
+
+	ServerSetActiveSlotPredicted(SlotTag, PredictionKey);
+}
+
+void UEquipmentManagerComponent::ServerSetActiveSlotPredicted_Implementation(FGameplayTag SlotTag, FPredictionKey PredictionKey)
+{
+	if (!AbilitySystemComponent)
+	{
+		ClientRejectActiveSlotPrediction(PredictionKey);
+		return;
+	}
+
+	// Replicates the key back to the client when the scope ends
+
+	FScopedPredictionWindow ScopedPrediction(AbilitySystemComponent, PredictionKey);
+
+	if (!HasReachedInitState(TAG_InitState_GameplayReady) || (EquipmentContainer.FindEntryIndex(SlotTag) == INDEX_NONE))
+	{
+		ClientRejectActiveSlotPrediction(PredictionKey);
+		return;
+	}
+
+	// Shares the rate limit and the validation with the other slot requests from the client
+
+	FEquipmentSlotRequest Request;
+	Request.Type = EEquipmentRequestType::Activate;
+	Request.SlotTag = SlotTag;
 
-	auto LastActiveIndex{ static_cast<int32>(INDEX_NONE) };
-	auto NewActiveIndex{ static_cast<int32>(INDEX_NONE) };
+	if (!ConsumeRequestToken())
+	{
+		UE_LOG(LogGAEA, Verbose, TEXT("Rejected predicted active slot(%s) from %s: rate limit exceeded."), *SlotTag.GetTagName().ToString(), *GetNameSafe(GetOwner()));
+
+		ClientRejectActiveSlotPrediction(PredictionKey);
+		return;
+	}
+
+	if (!CanAcceptEquipmentRequest(Request))
+	{
+		UE_LOG(LogGAEA, Verbose, TEXT("Rejected predicted active slot(%s) from %s."), *SlotTag.GetTagName().ToString(), *GetNameSafe(GetOwner()));
+
+		ClientRejectActiveSlotPrediction(PredictionKey);
+		return;
+	}
+
+	SetActiveSlot(SlotTag);
+}
+
+void UEquipmentManagerComponent::ClientRejectActiveSlotPrediction_Implementation(FPredictionKey PredictionKey)
+{
+	FPredictionKeyDelegates::BroadcastRejectedDelegate(PredictionKey.Current);
+}
+
+void UEquipmentManagerComponent::HandleActiveSlotPredictionRejected(FPredictionKey::KeyType PredictionKey)
+{
+	// Ignore predictions already replaced by a newer one
 
-	for (auto It{ EquipmentContainer.Entries.CreateIterator() }; It; ++It)
+	if (!IsPredictingActiveSlot() || (PredictionKey != ActiveSlotPredictionKey))
 	{
-		auto& Entry{ *It };
+		return;
+	}
+
+	// The server did not apply the change, so roll back at once
+
+	EndActiveSlotPrediction();
+}
+
+void UEquipmentManagerComponent::HandleActiveSlotPredictionCaughtUp(FPredictionKey::KeyType PredictionKey)
+{
+	// Ignore predictions already replaced by a newer one
+
+	if (!IsPredictingActiveSlot() || (PredictionKey != ActiveSlotPredictionKey))
+	{
+		return;
+	}
+
+	// The key can catch up before the container is replicated, so only end the prediction if the state already matches
 
-		if (Entry.Activated)
+	ReconcileActiveSlotPrediction();
+
+	// Otherwise wait for the replicated container, but roll back if it never arrives
+
+	if (IsPredictingActiveSlot())
+	{
+		if (auto* World{ GetWorld() })
 		{
-			LastActiveIndex = It.GetIndex();
+			World->GetTimerManager().SetTimer(ActiveSlotPredictionTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::HandleActiveSlotPredictionTimeout, PredictionKey), FMath::Max(ActiveSlotPredictionTimeout, KINDA_SMALL_NUMBER), false);
 		}
-
-		if (Entry.SlotTag == SlotTag)
+		else
 		{
-			NewActiveIndex = It.GetIndex();
+			EndActiveSlotPrediction();
 		}
 	}
+}
 
-	// Check if the new active slot index is valid
-
-	if ((NewActiveIndex == INDEX_NONE) || (NewActiveIndex == LastActiveIndex))
+void UEquipmentManagerComponent::HandleActiveSlotPredictionTimeout(FPredictionKey::KeyType PredictionKey)
+{
+	if (!IsPredictingActiveSlot() || (PredictionKey != ActiveSlotPredictionKey))
 	{
 		return;
 	}
 
-	// Set active slot
-	
-	if (LastActiveIndex != INDEX_NONE)
+	UE_LOG(LogGAEA, Verbose, TEXT("Active slot prediction (%s) timed out on %s, rolling back"), *PredictedActiveSlotTag.ToString(), *GetNameSafe(GetOwner()));
+
+	EndActiveSlotPrediction();
+}
+
+void UEquipmentManagerComponent::ReconcileActiveSlotPrediction()
+{
+	const auto AuthoritativeIndex{ EquipmentContainer.GetAuthoritativeActiveEntryIndex() };
+
+	if (EquipmentContainer.Entries.IsValidIndex(AuthoritativeIndex) && (EquipmentContainer.Entries[AuthoritativeIndex].SlotTag == PredictedActiveSlotTag))
 	{
-		EquipmentContainer.DeactivateEntry(LastActiveIndex);
+		EndActiveSlotPrediction();
 	}
+}
 
-	EquipmentContainer.ActivateEntry(NewActiveIndex);
+void UEquipmentManagerComponent::EndActiveSlotPrediction()
+{
+	PredictedActiveSlotTag = FGameplayTag::EmptyTag;
+	ActiveSlotPredictionKey = 0;
+
+	if (auto* World{ GetWorld() })
+	{
+		World->GetTimerManager().ClearTimer(ActiveSlotPredictionTimerHandle);
+	}
+
+	EquipmentContainer.ApplyLocalActiveEntry(EquipmentContainer.GetAuthoritativeActiveEntryIndex());
 }
 
 bool UEquipmentManagerComponent::GetActiveSlotInfo(FEquipmentSlotChangedMessage& SlotInfo)
 {
 	SlotInfo = FEquipmentSlotChangedMessage();
 
-	for (const auto& Entry : EquipmentContainer.Entries)
+	if (const auto* Entry{ EquipmentContainer.GetActiveEntry() })
 	{
-		if (Entry.Activated)
-		{
-			SlotInfo.OwnerComponent = this;
-			SlotInfo.SlotTag = Entry.SlotTag;
-			SlotInfo.Instance = Entry.Instance;
-			SlotInfo.Data = Entry.Data;
+		SlotInfo.OwnerComponent = this;
+		SlotInfo.SlotTag = Entry->SlotTag;
+		SlotInfo.Instance = Entry->Instance;
+		SlotInfo.Data = Entry->Data;
 
-			return true;
-		}
+		return true;
 	}
 
 	return false;
@@ -548,20 +1291,241 @@ bool UEquipmentManagerComponent::GetSlotInfo(FGameplayTag SlotTag, FEquipmentSlo
 {
 	SlotInfo = FEquipmentSlotChangedMessage();
 
+	if (const auto* Entry{ EquipmentContainer.FindEntry(SlotTag) })
+	{
+		SlotInfo.OwnerComponent = this;
+		SlotInfo.SlotTag = Entry->SlotTag;
+		SlotInfo.Instance = Entry->Instance;
+		SlotInfo.Data = Entry->Data;
+
+		return true;
+	}
+
+	return false;
+}
+
+#pragma endregion
+
+
+#pragma region Equipment Preload
+
+bool UEquipmentManagerComponent::IsSlotReady(FGameplayTag SlotTag) const
+{
+	const auto* Entry{ EquipmentContainer.FindEntry(SlotTag) };
+
+	return Entry && IsEquipmentDataReady(Entry->Data);
+}
+
+bool UEquipmentManagerComponent::IsEquipmentDataReady(const UEquipmentData* EquipmentData) const
+{
+	const auto* Handle{ PendingPreloads.Find(FObjectKey(EquipmentData)) };
+
+	return !Handle || !Handle->IsValid() || (*Handle)->HasLoadCompleted();
+}
+
+bool UEquipmentManagerComponent::RequestEquipmentPreload(FGameplayTag SlotTag, const UEquipmentData* EquipmentData)
+{
+	if (!bPreloadEquipmentBundles || !EquipmentData)
+	{
+		return true;
+	}
+
+	// Already loading
+
+	if (!IsEquipmentDataReady(EquipmentData))
+	{
+		return false;
+	}
+
+	// Load bundles through AssetManager
+	// If the loading has already finished, treat it as ready without waiting for the callback
+
+	const auto AssetId{ EquipmentData->GetPrimaryAssetId() };
+
+	if (AssetId.IsValid())
+	{
+		const auto Delegate{ FStreamableDelegate::CreateUObject(this, &ThisClass::HandleEquipmentPreloaded, TWeakObjectPtr<const UEquipmentData>(EquipmentData)) };
+
+		auto Handle{ UAssetManager::Get().LoadPrimaryAsset(AssetId, PreloadBundleNames, Delegate) };
+
+		if (Handle.IsValid() && !Handle->HasLoadCompleted())
+		{
+			Handle->BindCancelDelegate(FStreamableDelegate::CreateUObject(this, &ThisClass::HandleEquipmentPreloadCancelled, TWeakObjectPtr<const UEquipmentData>(EquipmentData)));
+
+			PendingPreloads.Add(FObjectKey(EquipmentData), Handle);
+
+			return false;
+		}
+	}
+
+	if (const auto* Entry{ EquipmentContainer.FindEntry(SlotTag) })
+	{
+		BroadcastEquipmentReady(*Entry);
+	}
+
+	return true;
+}
+
+bool UEquipmentManagerComponent::DeferActivationUntilReady(const FEquipmentEntry& Entry)
+{
+	if (IsEquipmentDataReady(Entry.Data))
+	{
+		return false;
+	}
+
+	PendingActivationSlotTags.AddUnique(Entry.SlotTag);
+
+	return true;
+}
+
+bool UEquipmentManagerComponent::CancelDeferredActivation(FGameplayTag SlotTag)
+{
+	return (PendingActivationSlotTags.Remove(SlotTag) > 0);
+}
+
+void UEquipmentManagerComponent::HandleEquipmentPreloaded(TWeakObjectPtr<const UEquipmentData> EquipmentData)
+{
+	if (PendingPreloads.Remove(FObjectKey(EquipmentData.Get())) <= 0)
+	{
+		return;
+	}
+
+	// Run delayed activations of the Equipment
+
+	for (auto It{ PendingActivationSlotTags.CreateIterator() }; It; ++It)
+	{
+		const auto* Entry{ EquipmentContainer.FindEntry(*It) };
+
+		if (!Entry || !Entry->IsValid() || !Entry->bLocallyActivated)
+		{
+			It.RemoveCurrent();
+		}
+		else if (Entry->Data == EquipmentData.Get())
+		{
+			It.RemoveCurrent();
+
+			Entry->Data->HandleDeferredActivated(this, Entry->Instance);
+		}
+	}
+
+	// Notify slots using the EquipmentData
+
 	for (const auto& Entry : EquipmentContainer.Entries)
 	{
-		if (Entry.SlotTag == SlotTag)
+		if (Entry.IsValid() && (Entry.Data == EquipmentData.Get()))
+		{
+			BroadcastEquipmentReady(Entry);
+		}
+	}
+}
+
+void UEquipmentManagerComponent::HandleEquipmentPreloadCancelled(TWeakObjectPtr<const UEquipmentData> EquipmentData)
+{
+	if (PendingPreloads.Remove(FObjectKey(EquipmentData.Get())) <= 0)
+	{
+		return;
+	}
+
+	// Drop delayed activations of the Equipment without executing them
+
+	PendingActivationSlotTags.RemoveAll(
+		[this, &EquipmentData](const FGameplayTag& SlotTag)
 		{
-			SlotInfo.OwnerComponent = this;
-			SlotInfo.SlotTag = Entry.SlotTag;
-			SlotInfo.Instance = Entry.Instance;
-			SlotInfo.Data = Entry.Data;
+			const auto* Entry{ EquipmentContainer.FindEntry(SlotTag) };
+
+			return !Entry || (Entry->Data == EquipmentData.Get());
+		});
+}
+
+void UEquipmentManagerComponent::BroadcastEquipmentReady(const FEquipmentEntry& Entry)
+{
+	FEquipmentSlotChangedMessage Message;
+	Message.OwnerComponent = this;
+	Message.SlotTag = Entry.SlotTag;
+	Message.Data = Entry.Data;
+	Message.Instance = Entry.Instance;
+
+	OnEquipmentReady.Broadcast(Message);
+}
+
+#pragma endregion
+
+
+#pragma region Mesh Cache
+
+USkeletalMeshComponent* UEquipmentManagerComponent::AcquireEquipmentMesh(const FEquipmentMeshToSpawn& SpawnInfo, const AActor* Owner)
+{
+	return IsMeshCacheEnabled() ? MeshCache.AcquireMesh(SpawnInfo, Owner) : nullptr;
+}
+
+bool UEquipmentManagerComponent::ReleaseEquipmentMesh(USkeletalMeshComponent* Component)
+{
+	return IsMeshCacheEnabled() ? MeshCache.ReleaseMesh(Component, static_cast<int64>(MeshCacheBudgetKB) * 1024) : false;
+}
+
+void UEquipmentManagerComponent::SetMeshCacheBudgetKB(int32 NewBudgetKB)
+{
+	MeshCacheBudgetKB = FMath::Max(NewBudgetKB, 0);
+
+	MeshCache.Trim(static_cast<int64>(MeshCacheBudgetKB) * 1024);
+}
+
+#pragma endregion
+
+
+#pragma region Mesh Resolution
+
+USkeletalMeshComponent* UEquipmentManagerComponent::GetMeshByTag(UObject* MeshAccessor, FGameplayTag MeshTypeTag)
+{
+	if (!MeshAccessor)
+	{
+		return nullptr;
+	}
+
+	// Discard the meshes resolved for another accessor
+
+	if (MeshByTagCacheAccessor != MeshAccessor)
+	{
+		InvalidateMeshByTagCache();
+
+		MeshByTagCacheAccessor = MeshAccessor;
+	}
 
-			return true;
+	// Return the cached mesh while it is still in use by the pawn
+
+	if (const auto* CachedMesh{ MeshByTagCache.Find(MeshTypeTag) })
+	{
+		auto* Mesh{ CachedMesh->Get() };
+		if (Mesh && Mesh->IsRegistered())
+		{
+			return Mesh;
 		}
+
+		// The mesh set of the pawn has changed
+
+		InvalidateMeshByTagCache();
+
+		MeshByTagCacheAccessor = MeshAccessor;
 	}
 
-	return false;
+	INC_DWORD_STAT(STAT_GAEA_MeshByTagCacheMisses);
+
+	auto* Mesh{ ICharacterMeshAccessorInterface::Execute_GetMeshByTag(MeshAccessor, MeshTypeTag) };
+
+	// Tags without a mesh are not cached, since the mesh may be added to the pawn later
+
+	if (Mesh)
+	{
+		MeshByTagCache.Add(MeshTypeTag, Mesh);
+	}
+
+	return Mesh;
+}
+
+void UEquipmentManagerComponent::InvalidateMeshByTagCache()
+{
+	MeshByTagCache.Reset();
+	MeshByTagCacheAccessor.Reset();
 }
 
 #pragma endregion
@@ -6,8 +6,13 @@
 
 #include "EquipmentSet.h"
 #include "EquipmentContainer.h"
+#include "EquipmentTransaction.h"
+#include "EquipmentRequest.h"
+#include "Pool/EquipmentMeshCache.h"
 #include "EquipmentSlotChangeMessage.h"
 
+#include "GameplayPrediction.h"
+
 #include "EquipmentManagerComponent.generated.h"
 
 class EquipmentSet;
@@ -15,6 +20,7 @@ class UEquipmentData;
 class UEquipmentInstance;
 class APawn;
 class UAbilitySystemComponent;
+struct FStreamableHandle;
 
 
 /**
@@ -22,6 +28,61 @@ class UAbilitySystemComponent;
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEquipmentSlotEventDelegate, FEquipmentSlotChangedMessage, Param);
 
+/**
+ * Delegate to notify changes in multiple EquipmentSlots by an equipment transaction
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEquipmentSlotsEventDelegate, FEquipmentSlotsChangedMessage, Param);
+
+/**
+ * Native versions of the above delegates for C++ listeners, which receive the message by reference
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FEquipmentSlotEventNativeDelegate, const FEquipmentSlotChangedMessage&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FEquipmentSlotsEventNativeDelegate, const FEquipmentSlotsChangedMessage&);
+
+/**
+ * Delegate to notify a listener registered for a specific EquipmentSlot
+ */
+DECLARE_DELEGATE_OneParam(FEquipmentSlotListenerDelegate, const FEquipmentSlotChangedMessage&);
+
+
+/**
+ * How the slot tag of a slot listener is matched against the changed slot
+ */
+enum class EEquipmentSlotMatch : uint8
+{
+	// Only the slot with the same tag
+	ExactMatch,
+
+	// The slot with the same tag and all of its child slots
+	IncludeChildren
+};
+
+
+/**
+ * Listener registered in UEquipmentManagerComponent for a specific EquipmentSlot
+ */
+struct FEquipmentSlotListener
+{
+public:
+	FEquipmentSlotListener() {}
+
+public:
+	FDelegateHandle Handle;
+
+	EEquipmentSlotMatch MatchType{ EEquipmentSlotMatch::ExactMatch };
+
+	//
+	// Called when Equipment in the slot is changed
+	//
+	FEquipmentSlotListenerDelegate OnSlotChanged;
+
+	//
+	// Called when the slot is activated or when the active slot is changed from it
+	//
+	FEquipmentSlotListenerDelegate OnActiveSlotChanged;
+
+};
+
 
 /**
  * Components for managing Equipment
@@ -30,6 +91,9 @@ UCLASS(meta = (BlueprintSpawnableComponent))
 class GAEADDON_API UEquipmentManagerComponent : public UGFCPawnComponent
 {
 	GENERATED_BODY()
+
+	friend struct FEquipmentContainer;
+
 public:
 	UEquipmentManagerComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
@@ -57,6 +121,7 @@ public:
 protected:
 	virtual bool CanChangeInitStateToDataInitialized(UGameFrameworkComponentManager* Manager) const override;
 	virtual void HandleChangeInitStateToDataInitialized(UGameFrameworkComponentManager* Manager) override;
+	virtual bool CanChangeInitStateToGameplayReady(UGameFrameworkComponentManager* Manager) const override;
 
 	////////////////////////////////////////////////////////////////////////////////////
 	// Equipment Container
@@ -65,6 +130,9 @@ private:
 	UPROPERTY(Replicated)
 	FEquipmentContainer EquipmentContainer;
 
+public:
+	const FEquipmentContainer& GetEquipmentContainer() const { return EquipmentContainer; }
+
 public:
 	UPROPERTY(BlueprintAssignable)
 	FEquipmentSlotEventDelegate OnEquipmentSlotChange;
@@ -72,11 +140,242 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FEquipmentSlotEventDelegate OnActiveEquipmentSlotChange;
 
+	UPROPERTY(BlueprintAssignable)
+	FEquipmentSlotsEventDelegate OnEquipmentSlotsChange;
+
+	//
+	// Native delegates broadcast together with the above
+	// 
+	// Tips:
+	//	Prefer these from C++ as they avoid ProcessEvent and copying the message.
+	//
+	FEquipmentSlotEventNativeDelegate OnEquipmentSlotChangeNative;
+	FEquipmentSlotEventNativeDelegate OnActiveEquipmentSlotChangeNative;
+	FEquipmentSlotsEventNativeDelegate OnEquipmentSlotsChangeNative;
+
 public:
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 	virtual void ReadyForReplication() override;
 
 
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Active Slot Replication
+#pragma region Active Slot Replication
+protected:
+	//
+	// Replication policy for each slot, which overrides ReplicationPolicy of EquipmentData
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (Categories = "Equipment.Slot"))
+	TMap<FGameplayTag, EEquipmentReplicationPolicy> SlotReplicationPolicies;
+
+public:
+	EEquipmentReplicationPolicy GetReplicationPolicy(const FEquipmentEntry& Entry) const;
+
+protected:
+	/**
+	 * Returns the net condition of the registered subobject for the instance of the entry
+	 */
+	ELifetimeCondition GetInstanceNetCondition(const FEquipmentEntry& Entry) const;
+
+protected:
+	//
+	// Whether to replicate the active slot as a single tag instead of the Activated of each entry
+	// 
+	// Tips:
+	//	Entries are not marked dirty on activation, so changing the active slot only sends this tag.
+	// 
+	// Note:
+	//	Must be the same on the server and clients, so it can only be set by default.
+	//
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication")
+	bool bReplicateActiveSlotSeparately{ false };
+
+	//
+	// Slot of the currently activated Equipment, replicated when bReplicateActiveSlotSeparately is enabled
+	//
+	UPROPERTY(Transient, ReplicatedUsing = "OnRep_ReplicatedActiveSlotTag")
+	FGameplayTag ReplicatedActiveSlotTag;
+
+protected:
+	UFUNCTION()
+	virtual void OnRep_ReplicatedActiveSlotTag();
+
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Deferred Slot Change Message
+#pragma region Deferred Slot Change Message
+protected:
+	//
+	// Whether to hold slot change messages and broadcast them once at the end of frame
+	// 
+	// Tips:
+	//	Multiple changes to the same slot in a frame are collapsed into one message with the final state.
+	//	Listeners are no longer called while the Equipment is being changed or replicated.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Message")
+	bool bDeferSlotChangeMessages{ false };
+
+	//
+	// Whether to also broadcast SlotChange and ActiveSlotChange for each slot changed by an equipment transaction
+	// 
+	// Tips:
+	//	By default a transaction only broadcasts one SlotsChange message listing every slot it changed.
+	//	Enable this only for listeners that predate the SlotsChange message and still rely on the per-slot messages.
+	// 
+	// Note:
+	//	Listeners registered with RegisterSlotListener are always called for their slot.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Message")
+	bool bSendSlotMessagesInTransactions{ false };
+
+private:
+	FDelegateHandle DeferredMessageFlushHandle;
+
+public:
+	/**
+	 * Immediately broadcasts the slot change messages held until the end of frame
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	void FlushSlotChangeMessages();
+
+protected:
+	void ScheduleSlotChangeMessageFlush();
+
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Slot Listener
+#pragma region Slot Listener
+private:
+	//
+	// Listeners for each registered slot tag
+	//
+	TMap<FGameplayTag, TArray<FEquipmentSlotListener>> SlotListeners;
+
+	//
+	// Slot of the last active slot change dispatched to the listeners
+	//
+	FGameplayTag LastDispatchedActiveSlotTag;
+
+public:
+	/**
+	 * Registers a listener that is only called for changes of the specified slot.
+	 * Returns a handle to unregister the listener.
+	 * 
+	 * Tips:
+	 *	With IncludeChildren, changes of child slots (e.g. "Equipment.Slot.Weapon.Primary" for "Equipment.Slot.Weapon") are also notified.
+	 */
+	FDelegateHandle RegisterSlotListener(
+		FGameplayTag SlotTag,
+		EEquipmentSlotMatch MatchType,
+		FEquipmentSlotListenerDelegate OnSlotChanged,
+		FEquipmentSlotListenerDelegate OnActiveSlotChanged = FEquipmentSlotListenerDelegate());
+
+	void UnregisterSlotListener(FDelegateHandle Handle);
+
+	/**
+	 * Unregisters all listeners bound to the specified object
+	 */
+	void UnregisterSlotListeners(const void* UserObject);
+
+protected:
+	void DispatchSlotChangeToListeners(const FEquipmentSlotChangedMessage& Message) const;
+	void DispatchActiveSlotChangeToListeners(const FEquipmentSlotChangedMessage& Message);
+
+	/**
+	 * Collects the listeners for the slot, including the listeners of parent slots registered with IncludeChildren
+	 */
+	void GatherSlotListeners(FGameplayTag SlotTag, bool bActiveSlotChange, TArray<FEquipmentSlotListenerDelegate, TInlineAllocator<8>>& OutDelegates) const;
+
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Equipment Transaction
+#pragma region Equipment Transaction
+private:
+	//
+	// Changes collected while the equipment transaction is open
+	//
+	UPROPERTY(Transient)
+	FEquipmentTransaction PendingTransaction;
+
+protected:
+	//
+	// Whether to keep the Equipment of slots that have the same EquipmentData after a transaction removing all Equipment
+	// 
+	// Tips:
+	//	ResetEquipments with the same loadout (e.g. on respawn) only changes the slots whose Equipment is different.
+	//	The entry, instance, StatTags and granted abilities of the kept Equipment remain as they are.
+	// 
+	// Note:
+	//	StatTags of the kept Equipment are not reset to their initial values.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Equipment")
+	bool bKeepUnchangedEquipments{ false };
+
+	//
+	// Number of nested equipment transactions currently open
+	//
+	int32 TransactionDepth{ 0 };
+
+public:
+	/**
+	 * Opens an equipment transaction.
+	 * Until the transaction is committed, changes to Equipment and the active slot are only collected.
+	 * 
+	 * Tips:
+	 *	Transactions can be nested. Changes are applied when the outermost transaction is committed.
+	 *	Prefer FScopedEquipmentTransaction so that the transaction is always committed.
+	 *	From Blueprint, use RequestEquipmentChanges to apply multiple changes together.
+	 */
+	void BeginEquipmentTransaction();
+
+	/**
+	 * Commits an equipment transaction.
+	 * Collected changes are applied together, the changed entries are marked dirty once 
+	 * and the final state of each changed slot is notified.
+	 */
+	void CommitEquipmentTransaction();
+
+	/**
+	 * Returns whether the equipment transaction is open
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment")
+	bool IsInEquipmentTransaction() const { return TransactionDepth > 0; }
+
+protected:
+	/**
+	 * Apply the changes collected in the transaction
+	 */
+	virtual void ApplyEquipmentTransaction(const FEquipmentTransaction& Transaction);
+
+	/**
+	 * Remove only the entries that will not have the same Equipment after the transaction removing all Equipment
+	 */
+	void RemoveChangedEntries(const FEquipmentTransaction& Transaction);
+
+	/**
+	 * Activate the Equipment in the specified slot and deactivate the previous one
+	 */
+	void ApplyActiveSlot(FGameplayTag SlotTag);
+
+	void AddReplicatedEquipmentInstance(FEquipmentEntry& Entry);
+	void RemoveReplicatedEquipmentInstance(UEquipmentInstance* Instance);
+
+	/**
+	 * Re-register the instance if the net condition for its current activation state has changed
+	 */
+	void RefreshReplicatedEquipmentInstance(FEquipmentEntry& Entry);
+
 #pragma endregion
 
 
@@ -102,6 +401,21 @@ protected:
 	 */
 	virtual void ApplyInitialEquipmentSet();
 
+private:
+	//
+	// Whether the initial equipment set is waiting in the grant queue of the world (server only)
+	// 
+	// Tips:
+	//	This component does not become GameplayReady until it has been applied.
+	//
+	bool bInitialEquipmentSetQueued{ false };
+
+public:
+	/**
+	 * Called by UEquipmentGrantQueueSubsystem when the queued initial equipment set of this component can be applied
+	 */
+	void ApplyQueuedInitialEquipmentSet();
+
 public:
 	/**
 	 * Set the initial equipment set
@@ -130,15 +444,25 @@ public:
 
 	/**
 	 * Adds Equipment to the specified Slot.
+	 * Returns whether the change is valid and has been queued.
 	 * 
 	 * Tips:
-	 *	If you want to add more than one Equipments, use ResetEquipments.
+	 *	If you want to add more than one Equipments, use ResetEquipments, RequestEquipmentChanges or an equipment transaction.
+	 * 
+	 * Note:
+	 *	Inside an equipment transaction, the change is applied when the outermost transaction is committed.
+	 *	Otherwise it has already been applied when this returns.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment", meta = (GameplayTagFilter = "Equipment.Slot"))
 	bool AddEquipment(FGameplayTag SlotTag, const UEquipmentData* EquipmentData, bool ActivateImmediately = true);
 
 	/**
 	 * Remove the Equipment in the specified Slot.
+	 * Returns whether the slot has Equipment (taking the open transaction into account) and the removal has been queued.
+	 * 
+	 * Note:
+	 *	Inside an equipment transaction, the change is applied when the outermost transaction is committed.
+	 *	Otherwise it has already been applied when this returns.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment", meta = (GameplayTagFilter = "Equipment.Slot"))
 	bool RemoveEquipment(FGameplayTag SlotTag);
@@ -152,6 +476,100 @@ public:
 #pragma endregion
 
 
+	////////////////////////////////////////////////////////////////////////////////////
+	// Equipment Request
+#pragma region Equipment Request
+protected:
+	//
+	// Maximum number of slot requests accepted in a single call of RequestEquipmentChanges
+	// 
+	// Tips:
+	//	Larger batches are dropped as a whole.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Request", meta = (ClampMin = 1))
+	int32 MaxRequestsPerBatch{ 16 };
+
+	//
+	// Maximum number of slot requests that can be processed at once after the client has been idle
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Request", meta = (ClampMin = 1.0))
+	float RequestBurstCapacity{ 8.0f };
+
+	//
+	// Number of slot requests the client can make per second on a sustained basis
+	// 
+	// Note:
+	//	Requests exceeding the limit are dropped on the server.
+	//	Predicted active slot changes (SetActiveSlotPredicted) share the same limit and are rejected when it is exceeded.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Request", meta = (ClampMin = 0.0))
+	float RequestsPerSecond{ 4.0f };
+
+	//
+	// Equipment that the owning client is allowed to add with RequestEquipmentChanges
+	// 
+	// Tips:
+	//	Empty by default, so clients cannot add any Equipment.
+	//	Override CanClientAddEquipment to check ownership (e.g. the player's inventory) instead of a fixed list.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Request")
+	TArray<TObjectPtr<const UEquipmentData>> ClientAddableEquipments;
+
+private:
+	//
+	// Rate limit of the requests from the connection owning this component (server only)
+	//
+	FEquipmentRequestTokenBucket RequestTokenBucket;
+
+public:
+	/**
+	 * Requests changes to multiple slots from the owning client.
+	 * Changes are sent to the server in a single RPC and applied together in an equipment transaction.
+	 * 
+	 * Tips:
+	 *	On the server, the requests are applied directly without the rate limit.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	void RequestEquipmentChanges(const TArray<FEquipmentSlotRequest>& Requests);
+
+protected:
+	UFUNCTION(Server, Reliable)
+	void ServerRequestEquipmentChanges(const TArray<FEquipmentSlotRequest>& Requests);
+
+	/**
+	 * Apply the slot requests in an equipment transaction.
+	 * Requests from the client are rate limited and skipped unless CanAcceptEquipmentRequest accepts them.
+	 */
+	void ApplyEquipmentRequests(const TArray<FEquipmentSlotRequest>& Requests, bool bFromClient);
+
+	/**
+	 * Consumes a token of the rate limit for a request from the client.
+	 * Returns false if the limit is exceeded.
+	 */
+	bool ConsumeRequestToken();
+
+public:
+	/**
+	 * Returns whether the slot request from the client can be accepted.
+	 * 
+	 * Tips:
+	 *	Add is only accepted if CanClientAddEquipment approves the Equipment.
+	 */
+	virtual bool CanAcceptEquipmentRequest(const FEquipmentSlotRequest& Request) const;
+
+protected:
+	/**
+	 * Returns whether the owning client may add the Equipment to the slot.
+	 * 
+	 * Tips:
+	 *	By default only Equipment in ClientAddableEquipments is approved.
+	 *	Override to approve Equipment owned by the player instead.
+	 */
+	virtual bool CanClientAddEquipment(const UEquipmentData* EquipmentData, FGameplayTag SlotTag) const;
+
+#pragma endregion
+
+
 	////////////////////////////////////////////////////////////////////////////////////
 	// Active Slot
 #pragma region Active Slot
@@ -163,6 +581,23 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment", meta = (GameplayTagFilter = "Equipment.Slot"))
 	void SetActiveSlot(FGameplayTag SlotTag);
 
+	/**
+	 * Changing an Active Slot from the locally controlled client without waiting for the server.
+	 * OnActivated/OnDeactivated are executed locally at once and the change is requested to the server with a prediction key.
+	 * If the server rejects it, or the replicated state still does not match ActiveSlotPredictionTimeout seconds after the key is caught up, the local change is rolled back.
+	 * 
+	 * Tips:
+	 *	On the server, this is the same as SetActiveSlot.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Equipment", meta = (GameplayTagFilter = "Equipment.Slot"))
+	void SetActiveSlotPredicted(FGameplayTag SlotTag);
+
+	/**
+	 * Returns whether the active slot changed by SetActiveSlotPredicted is waiting for the server
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment")
+	bool IsPredictingActiveSlot() const { return PredictedActiveSlotTag.IsValid(); }
+
 	/**
 	 * Gets Equipment Data, Instance, and SlotTag of the active slot.
 	 */
@@ -175,6 +610,226 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Equipment", meta = (GameplayTagFilter = "Equipment.Slot"))
 	bool GetSlotInfo(FGameplayTag SlotTag, FEquipmentSlotChangedMessage& SlotInfo);
 
+protected:
+	//
+	// Seconds to wait for the replicated active slot after the prediction key is caught up before rolling back
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prediction", meta = (ClampMin = 0.0))
+	float ActiveSlotPredictionTimeout{ 1.0f };
+
+private:
+	//
+	// Slot activated by SetActiveSlotPredicted that has not been resolved by the server yet
+	//
+	FGameplayTag PredictedActiveSlotTag;
+
+	//
+	// Key of the prediction of PredictedActiveSlotTag
+	//
+	FPredictionKey::KeyType ActiveSlotPredictionKey{ 0 };
+
+	//
+	// Timer to roll back a caught up prediction that never matched the replicated state
+	//
+	FTimerHandle ActiveSlotPredictionTimerHandle;
+
+protected:
+	UFUNCTION(Server, Reliable)
+	void ServerSetActiveSlotPredicted(FGameplayTag SlotTag, FPredictionKey PredictionKey);
+
+	UFUNCTION(Client, Reliable)
+	void ClientRejectActiveSlotPrediction(FPredictionKey PredictionKey);
+
+	/**
+	 * Called when the prediction key is rejected by the server
+	 */
+	void HandleActiveSlotPredictionRejected(FPredictionKey::KeyType PredictionKey);
+
+	/**
+	 * Called when the prediction key is caught up
+	 * Ends the prediction only if the replicated state already matches, otherwise starts the timeout
+	 */
+	void HandleActiveSlotPredictionCaughtUp(FPredictionKey::KeyType PredictionKey);
+
+	/**
+	 * Rolls back the prediction that did not match the replicated state in time
+	 */
+	void HandleActiveSlotPredictionTimeout(FPredictionKey::KeyType PredictionKey);
+
+	/**
+	 * Ends the prediction if the active slot replicated from the server matches the predicted one
+	 */
+	void ReconcileActiveSlotPrediction();
+
+	/**
+	 * Ends the prediction and applies the active slot replicated from the server locally
+	 */
+	void EndActiveSlotPrediction();
+
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Equipment Preload
+#pragma region Equipment Preload
+protected:
+	//
+	// Whether to load the asset bundles of EquipmentData asynchronously when Equipment is added
+	// 
+	// Tips:
+	//	While loading, only the fragments using the asset bundles (e.g. meshes, anim layers) are delayed until the loading is finished.
+	//	Abilities and other gameplay fragments are applied immediately.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Preload")
+	bool bPreloadEquipmentBundles{ false };
+
+	//
+	// Names of the asset bundles to be loaded
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Preload", meta = (EditCondition = "bPreloadEquipmentBundles"))
+	TArray<FName> PreloadBundleNames;
+
+private:
+	//
+	// Handles of loads in progress for each EquipmentData
+	//
+	TMap<FObjectKey, TSharedPtr<FStreamableHandle>> PendingPreloads;
+
+	//
+	// Slots whose activation is waiting for the loading to finish
+	//
+	TArray<FGameplayTag> PendingActivationSlotTags;
+
+public:
+	//
+	// Notified when the asset bundles of the Equipment in the slot are loaded
+	//
+	UPROPERTY(BlueprintAssignable)
+	FEquipmentSlotEventDelegate OnEquipmentReady;
+
+public:
+	/**
+	 * Returns whether the asset bundles of the Equipment in the specified slot are loaded
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment", meta = (GameplayTagFilter = "Equipment.Slot"))
+	bool IsSlotReady(FGameplayTag SlotTag) const;
+
+	bool IsEquipmentDataReady(const UEquipmentData* EquipmentData) const;
+
+protected:
+	/**
+	 * Start loading the asset bundles of EquipmentData.
+	 * Returns true if the loading has already finished.
+	 */
+	bool RequestEquipmentPreload(FGameplayTag SlotTag, const UEquipmentData* EquipmentData);
+
+	/**
+	 * If the Equipment is not ready, delay the activation of its fragments using the asset bundles until it is.
+	 * Returns true if delayed.
+	 */
+	bool DeferActivationUntilReady(const FEquipmentEntry& Entry);
+
+	/**
+	 * Cancel the delayed activation of the slot.
+	 * Returns true if there was a delayed activation.
+	 */
+	bool CancelDeferredActivation(FGameplayTag SlotTag);
+
+	void HandleEquipmentPreloaded(TWeakObjectPtr<const UEquipmentData> EquipmentData);
+
+	/**
+	 * Discards the loading and the delayed activations of EquipmentData without notifying it as ready
+	 */
+	void HandleEquipmentPreloadCancelled(TWeakObjectPtr<const UEquipmentData> EquipmentData);
+
+	void BroadcastEquipmentReady(const FEquipmentEntry& Entry);
+
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Mesh Cache
+#pragma region Mesh Cache
+protected:
+	//
+	// Memory budget (KB) for the mesh components of deactivated Equipment kept for reuse
+	// 
+	// Tips:
+	//	If 0 or less, the mesh components are destroyed when the Equipment is deactivated.
+	// 
+	// Note:
+	//	Each cached component is charged for itself and its anim instance. The mesh asset is shared and is not charged.
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mesh Cache", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 MeshCacheBudgetKB{ 0 };
+
+private:
+	UPROPERTY(Transient)
+	FEquipmentMeshCache MeshCache;
+
+public:
+	/**
+	 * Returns a cached mesh component that can be reused to spawn the specified mesh, or nullptr.
+	 */
+	USkeletalMeshComponent* AcquireEquipmentMesh(const FEquipmentMeshToSpawn& SpawnInfo, const AActor* Owner);
+
+	/**
+	 * Keeps the mesh component for reuse if it fits in the budget.
+	 * Returns false if it was not kept, in which case the caller should destroy it.
+	 */
+	bool ReleaseEquipmentMesh(USkeletalMeshComponent* Component);
+
+	/**
+	 * Set memory budget (KB) for the mesh cache
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	void SetMeshCacheBudgetKB(int32 NewBudgetKB);
+
+	bool IsMeshCacheEnabled() const { return MeshCacheBudgetKB > 0; }
+
+#pragma endregion
+
+
+	////////////////////////////////////////////////////////////////////////////////////
+	// Mesh Resolution
+#pragma region Mesh Resolution
+private:
+	//
+	// Meshes of the pawn resolved for each mesh type tag through ICharacterMeshAccessorInterface
+	// 
+	// Tips:
+	//	Tags for which no mesh was found are not cached.
+	// 
+	// Note:
+	//	Not a UPROPERTY. Meshes are owned by the pawn and are held weakly.
+	//
+	TMap<FGameplayTag, TWeakObjectPtr<USkeletalMeshComponent>> MeshByTagCache;
+
+	//
+	// Mesh accessor for which MeshByTagCache was built
+	//
+	TWeakObjectPtr<const UObject> MeshByTagCacheAccessor;
+
+public:
+	/**
+	 * Returns the mesh of the specified type from the mesh accessor. If not, nullptr is returned.
+	 * 
+	 * Tips:
+	 *	A found mesh is cached, so ICharacterMeshAccessorInterface is only called again after the cache is invalidated.
+	 *	Tags without a mesh are resolved again on every call.
+	 *	The cache is invalidated automatically when a cached mesh is destroyed or unregistered, or the accessor is changed.
+	 */
+	USkeletalMeshComponent* GetMeshByTag(UObject* MeshAccessor, FGameplayTag MeshTypeTag);
+
+	/**
+	 * Discard the cached meshes of the pawn.
+	 * 
+	 * Tips:
+	 *	Call this when meshes are replaced without destroying or unregistering the previous ones.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	void InvalidateMeshByTagCache();
+
 #pragma endregion
 
 
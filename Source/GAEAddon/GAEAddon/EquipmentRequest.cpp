@@ -0,0 +1,41 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentRequest.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentRequest)
+
+
+//////////////////////////////////////////////////////////////////////
+// FEquipmentRequestTokenBucket
+
+#pragma region FEquipmentRequestTokenBucket
+
+void FEquipmentRequestTokenBucket::Refill(double CurrentTime, float Capacity, float TokensPerSecond)
+{
+	if (LastRefillTime < 0.0)
+	{
+		Tokens = Capacity;
+	}
+	else
+	{
+		const auto ElapsedTime{ FMath::Max(CurrentTime - LastRefillTime, 0.0) };
+
+		Tokens = FMath::Min(Tokens + static_cast<float>(ElapsedTime) * TokensPerSecond, Capacity);
+	}
+
+	LastRefillTime = CurrentTime;
+}
+
+bool FEquipmentRequestTokenBucket::TryConsume()
+{
+	if (Tokens < 1.0f)
+	{
+		return false;
+	}
+
+	Tokens -= 1.0f;
+
+	return true;
+}
+
+#pragma endregion
@@ -0,0 +1,90 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+#include "EquipmentRequest.generated.h"
+
+class UEquipmentData;
+
+
+/**
+ * Type of change to a slot requested from the client
+ */
+UENUM(BlueprintType)
+enum class EEquipmentRequestType : uint8
+{
+	// Add Equipment to the slot
+	Add,
+
+	// Remove the Equipment in the slot
+	Remove,
+
+	// Activate the slot
+	Activate
+};
+
+
+/**
+ * Change to a slot requested from the client to EquipmentManagerComponent
+ */
+USTRUCT(BlueprintType)
+struct GAEADDON_API FEquipmentSlotRequest
+{
+	GENERATED_BODY()
+public:
+	FEquipmentSlotRequest() {}
+
+	FEquipmentSlotRequest(EEquipmentRequestType InType, FGameplayTag InSlotTag, const UEquipmentData* InEquipmentData = nullptr)
+		: Type(InType), SlotTag(InSlotTag), EquipmentData(InEquipmentData)
+	{
+	}
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	EEquipmentRequestType Type{ EEquipmentRequestType::Add };
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (Categories = "Equipment.Slot"))
+	FGameplayTag SlotTag{ FGameplayTag::EmptyTag };
+
+	//
+	// Equipment to be added
+	// 
+	// Note:
+	//	Only used for Add. Must be an asset loaded on the server so that it can be referenced over the network.
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TObjectPtr<const UEquipmentData> EquipmentData{ nullptr };
+
+};
+
+
+/**
+ * Token bucket that limits the number of requests processed over time
+ */
+struct GAEADDON_API FEquipmentRequestTokenBucket
+{
+public:
+	FEquipmentRequestTokenBucket() {}
+
+private:
+	float Tokens{ 0.0f };
+
+	double LastRefillTime{ -1.0 };
+
+public:
+	/**
+	 * Adds the tokens accumulated since the last refill.
+	 * The bucket is full on the first refill.
+	 */
+	void Refill(double CurrentTime, float Capacity, float TokensPerSecond);
+
+	/**
+	 * Consumes a token and returns true if there is one left
+	 */
+	bool TryConsume();
+
+	float GetTokens() const { return Tokens; }
+
+};
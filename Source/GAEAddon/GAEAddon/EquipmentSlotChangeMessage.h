@@ -35,3 +35,42 @@ public:
 	TObjectPtr<UEquipmentInstance> Instance{ nullptr };
 
 };
+
+
+/**
+ * Message when multiple slots in EquipmentManagerComponent are changed at once by an equipment transaction.
+ * 
+ * Note:
+ *	A transaction broadcasts only this message, not FEquipmentSlotChangedMessage for each slot,
+ *	unless bSendSlotMessagesInTransactions is enabled on the component.
+ */
+USTRUCT(BlueprintType)
+struct GAEADDON_API FEquipmentSlotsChangedMessage
+{
+	GENERATED_BODY()
+public:
+	FEquipmentSlotsChangedMessage() {}
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TObjectPtr<UEquipmentManagerComponent> OwnerComponent{ nullptr };
+
+	//
+	// Slots whose Equipment has been changed
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FGameplayTag> SlotTags;
+
+	//
+	// Slot active after the change
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FGameplayTag ActiveSlotTag{ FGameplayTag::EmptyTag };
+
+	//
+	// Whether the active slot has been changed
+	//
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bActiveSlotChanged{ false };
+
+};
@@ -0,0 +1,80 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTransaction.h"
+
+#include "EquipmentManagerComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentTransaction)
+
+
+//////////////////////////////////////////////////////////////////////
+// FEquipmentTransaction
+
+#pragma region FEquipmentTransaction
+
+void FEquipmentTransaction::AddEquipment(FGameplayTag SlotTag, const UEquipmentData* EquipmentData)
+{
+	SlotChanges.Add(SlotTag, EquipmentData);
+}
+
+void FEquipmentTransaction::RemoveEquipment(FGameplayTag SlotTag)
+{
+	SlotChanges.Add(SlotTag, nullptr);
+
+	if (ActiveSlotTag == SlotTag)
+	{
+		ActiveSlotTag = FGameplayTag::EmptyTag;
+	}
+}
+
+void FEquipmentTransaction::RemoveAllEquipments()
+{
+	bRemoveAll = true;
+	SlotChanges.Reset();
+	ActiveSlotTag = FGameplayTag::EmptyTag;
+}
+
+void FEquipmentTransaction::SetActiveSlot(FGameplayTag SlotTag)
+{
+	ActiveSlotTag = SlotTag;
+}
+
+
+bool FEquipmentTransaction::IsEmpty() const
+{
+	return !bRemoveAll && SlotChanges.IsEmpty() && !ActiveSlotTag.IsValid();
+}
+
+void FEquipmentTransaction::Reset()
+{
+	bRemoveAll = false;
+	SlotChanges.Reset();
+	ActiveSlotTag = FGameplayTag::EmptyTag;
+}
+
+#pragma endregion
+
+
+//////////////////////////////////////////////////////////////////////
+// FScopedEquipmentTransaction
+
+#pragma region FScopedEquipmentTransaction
+
+FScopedEquipmentTransaction::FScopedEquipmentTransaction(UEquipmentManagerComponent* InOwnerComponent)
+	: OwnerComponent(InOwnerComponent)
+{
+	if (OwnerComponent.IsValid())
+	{
+		OwnerComponent->BeginEquipmentTransaction();
+	}
+}
+
+FScopedEquipmentTransaction::~FScopedEquipmentTransaction()
+{
+	if (OwnerComponent.IsValid())
+	{
+		OwnerComponent->CommitEquipmentTransaction();
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,72 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+#include "EquipmentTransaction.generated.h"
+
+class UEquipmentData;
+class UEquipmentManagerComponent;
+
+
+/**
+ * Changes to Equipment collected while an equipment transaction is open in EquipmentManagerComponent.
+ * The changes are applied together when the transaction is committed.
+ */
+USTRUCT()
+struct GAEADDON_API FEquipmentTransaction
+{
+	GENERATED_BODY()
+public:
+	FEquipmentTransaction() {}
+
+public:
+	//
+	// Whether all Equipment registered before this transaction will be removed
+	//
+	UPROPERTY()
+	bool bRemoveAll{ false };
+
+	//
+	// Equipment to be registered in each slot
+	//
+	// Tips:
+	//	If the value is nullptr, the Equipment in the slot will be removed.
+	//
+	UPROPERTY()
+	TMap<FGameplayTag, TObjectPtr<const UEquipmentData>> SlotChanges;
+
+	//
+	// Slot to be activated after all the slots are changed
+	//
+	UPROPERTY()
+	FGameplayTag ActiveSlotTag;
+
+public:
+	void AddEquipment(FGameplayTag SlotTag, const UEquipmentData* EquipmentData);
+	void RemoveEquipment(FGameplayTag SlotTag);
+	void RemoveAllEquipments();
+	void SetActiveSlot(FGameplayTag SlotTag);
+
+	bool IsEmpty() const;
+	void Reset();
+
+};
+
+
+/**
+ * Opens an equipment transaction in EquipmentManagerComponent for the lifetime of the scope
+ */
+struct GAEADDON_API FScopedEquipmentTransaction
+{
+public:
+	FScopedEquipmentTransaction(UEquipmentManagerComponent* InOwnerComponent);
+	~FScopedEquipmentTransaction();
+
+	UE_NONCOPYABLE(FScopedEquipmentTransaction);
+
+private:
+	TWeakObjectPtr<UEquipmentManagerComponent> OwnerComponent;
+
+};
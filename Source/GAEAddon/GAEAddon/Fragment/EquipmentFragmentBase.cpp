@@ -21,43 +21,23 @@ UClass* UEquipmentFragmentBase::GetRequiredInstanceClass() const
 }
 #endif // WITH_EDITOR
 
-void UEquipmentFragmentBase::OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragmentBase::OnEquiped(const FEquipmentFragmentContext& Context) const
 {
-	const auto* Pawn{ Instance ? Instance->GetPawn() : nullptr };
-
-	UE_LOG(LogGAEA, Log, TEXT("[%s|%s] %s::OnEquiped")
-		, Pawn ? (Pawn->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT")) : TEXT("INVALID")
-		, Pawn ? (Pawn->IsLocallyControlled() ? TEXT("Local") : TEXT("Other")) : TEXT("INVALID")
-		, *GetNameSafe(this));
+	GAEALIFECYCLELOG(Context.Pawn, TEXT("%s %s::OnEquiped"), *GAEALifecycleLog::GetContextString(Context.Pawn), *GetNameSafe(this));
 }
 
-void UEquipmentFragmentBase::OnUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragmentBase::OnUnequiped(const FEquipmentFragmentContext& Context) const
 {
-	const auto* Pawn{ Instance ? Instance->GetPawn() : nullptr };
-
-	UE_LOG(LogGAEA, Log, TEXT("[%s|%s] %s::OnUnequiped")
-		, Pawn ? (Pawn->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT")) : TEXT("INVALID")
-		, Pawn ? (Pawn->IsLocallyControlled() ? TEXT("Local") : TEXT("Other")) : TEXT("INVALID")
-		, *GetNameSafe(this));
+	GAEALIFECYCLELOG(Context.Pawn, TEXT("%s %s::OnUnequiped"), *GAEALifecycleLog::GetContextString(Context.Pawn), *GetNameSafe(this));
 }
 
-void UEquipmentFragmentBase::OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragmentBase::OnActivated(const FEquipmentFragmentContext& Context) const
 {
-	const auto* Pawn{ Instance ? Instance->GetPawn() : nullptr };
-
-	UE_LOG(LogGAEA, Log, TEXT("[%s|%s] %s::OnActivated")
-		, Pawn ? (Pawn->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT")) : TEXT("INVALID")
-		, Pawn ? (Pawn->IsLocallyControlled() ? TEXT("Local") : TEXT("Other")) : TEXT("INVALID")
-		, *GetNameSafe(this));
+	GAEALIFECYCLELOG(Context.Pawn, TEXT("%s %s::OnActivated"), *GAEALifecycleLog::GetContextString(Context.Pawn), *GetNameSafe(this));
 }
 
-void UEquipmentFragmentBase::OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragmentBase::OnDeactivated(const FEquipmentFragmentContext& Context) const
 {
-	const auto* Pawn{ Instance ? Instance->GetPawn() : nullptr };
-
-	UE_LOG(LogGAEA, Log, TEXT("[%s|%s] %s::OnDeactivated")
-		, Pawn ? (Pawn->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT")) : TEXT("INVALID")
-		, Pawn ? (Pawn->IsLocallyControlled() ? TEXT("Local") : TEXT("Other")) : TEXT("INVALID")
-		, *GetNameSafe(this));
+	GAEALIFECYCLELOG(Context.Pawn, TEXT("%s %s::OnDeactivated"), *GAEALifecycleLog::GetContextString(Context.Pawn), *GetNameSafe(this));
 }
 
@@ -2,10 +2,24 @@
 
 #pragma once
 
+#include "EquipmentFragmentContext.h"
+
 #include "EquipmentFragmentBase.generated.h"
 
-class UEquipmentInstance;
-class UEquipmentManagerComponent;
+
+/**
+ * Lifecycle phases of Equipment in which the fragment is executed
+ */
+enum class EEquipmentFragmentPhase : uint8
+{
+	None		= 0,
+	Equiped		= 1 << 0,
+	Unequiped	= 1 << 1,
+	Activated	= 1 << 2,
+	Deactivated	= 1 << 3,
+	All			= Equiped | Unequiped | Activated | Deactivated
+};
+ENUM_CLASS_FLAGS(EEquipmentFragmentPhase);
 
 
 /**
@@ -26,25 +40,47 @@ public:
 	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) {}
 #endif
 
+public:
+	/**
+	 * Returns the phases in which this fragment needs to be executed.
+	 * 
+	 * Tips:
+	 *	UEquipmentData only calls the hooks of the returned phases.
+	 *	Override this to return only the phases whose hooks are implemented.
+	 */
+	virtual EEquipmentFragmentPhase GetHandledPhases() const { return EEquipmentFragmentPhase::All; }
+
+	/**
+	 * Returns whether this fragment uses assets of the Equipment asset bundle when activated.
+	 * 
+	 * Tips:
+	 *	While the bundle is being preloaded, OnActivated of such fragments is delayed until the loading is finished.
+	 *	Other fragments, such as ability grants, are executed immediately.
+	 * 
+	 * Note:
+	 *	OnDeactivated is skipped if the Equipment is deactivated before the delayed OnActivated is executed.
+	 */
+	virtual bool RequiresEquipmentBundle() const { return false; }
+
 public:
 	/**
 	 * Executed when Equipment is Equiped
 	 */
-	virtual void OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const;
+	virtual void OnEquiped(const FEquipmentFragmentContext& Context) const;
 
 	/**
 	 * Executed when Equipment is Unequiped
 	 */
-	virtual void OnUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const;
+	virtual void OnUnequiped(const FEquipmentFragmentContext& Context) const;
 
 	/**
 	 * Executed when Equipment is Activated
 	 */
-	virtual void OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const;
+	virtual void OnActivated(const FEquipmentFragmentContext& Context) const;
 
 	/**
 	 * Executed when Equipment is Deactivated
 	 */
-	virtual void OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const;
+	virtual void OnDeactivated(const FEquipmentFragmentContext& Context) const;
 
 };
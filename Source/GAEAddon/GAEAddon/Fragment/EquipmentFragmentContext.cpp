@@ -0,0 +1,45 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentFragmentContext.h"
+
+#include "EquipmentManagerComponent.h"
+#include "EquipmentInstance.h"
+
+#include "Character/CharacterMeshAccessorInterface.h"
+
+#include "GameFramework/Pawn.h"
+
+
+namespace EquipmentFragmentContext
+{
+	static APawn* ResolvePawn(UEquipmentInstance* Instance)
+	{
+		check(Instance);
+
+		return Instance->GetPawnChecked<APawn>();
+	}
+
+	static UObject* ResolveMeshAccessor(APawn* Pawn)
+	{
+		return Pawn->Implements<UCharacterMeshAccessorInterface>() ? Pawn : nullptr;
+	}
+}
+
+
+FEquipmentFragmentContext::FEquipmentFragmentContext(UEquipmentManagerComponent* InEMC, UEquipmentInstance* InInstance)
+	: EMC(InEMC)
+	, Instance(InInstance)
+	, Pawn(EquipmentFragmentContext::ResolvePawn(InInstance))
+	, AbilitySystemComponent(InEMC ? InEMC->GetAbilitySystemComponent() : nullptr)
+	, LocalRole(Pawn->GetLocalRole())
+	, bHasAuthority(LocalRole == ROLE_Authority)
+	, bIsLocallyControlled(Pawn->IsLocallyControlled())
+	, MeshAccessor(EquipmentFragmentContext::ResolveMeshAccessor(Pawn))
+{
+	check(EMC);
+}
+
+USkeletalMeshComponent* FEquipmentFragmentContext::GetMeshByTag(FGameplayTag MeshTypeTag) const
+{
+	return EMC->GetMeshByTag(MeshAccessor, MeshTypeTag);
+}
@@ -0,0 +1,71 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "GameplayTagContainer.h"
+
+class UEquipmentManagerComponent;
+class UEquipmentInstance;
+class UAbilitySystemComponent;
+class USkeletalMeshComponent;
+class APawn;
+
+
+/**
+ * Information about the owner of Equipment passed to the hooks of each fragment
+ * 
+ * Tips:
+ *	Built once per lifecycle transition by UEquipmentData and shared by all fragments executed in it,
+ *	so that each fragment does not need to resolve the pawn, ASC and net role again.
+ * 
+ * Note:
+ *	Only valid during the hook call. Do not keep a reference to it.
+ */
+struct GAEADDON_API FEquipmentFragmentContext
+{
+public:
+	FEquipmentFragmentContext(UEquipmentManagerComponent* InEMC, UEquipmentInstance* InInstance);
+
+	FEquipmentFragmentContext(const FEquipmentFragmentContext&) = delete;
+	FEquipmentFragmentContext& operator=(const FEquipmentFragmentContext&) = delete;
+
+public:
+	UEquipmentManagerComponent* const EMC;
+
+	UEquipmentInstance* const Instance;
+
+	//
+	// Pawn to which the Equipment belongs
+	//
+	APawn* const Pawn;
+
+	//
+	// AbilitySystemComponent of the EMC. May be nullptr if not yet initialized.
+	//
+	UAbilitySystemComponent* const AbilitySystemComponent;
+
+	//
+	// Local net role of the Pawn
+	//
+	const ENetRole LocalRole;
+
+	const bool bHasAuthority;
+
+	const bool bIsLocallyControlled;
+
+	//
+	// Object implementing ICharacterMeshAccessorInterface, or nullptr if the Pawn does not implement it
+	//
+	UObject* const MeshAccessor;
+
+public:
+	/**
+	 * Returns the mesh of the specified type from the MeshAccessor. If not, nullptr is returned.
+	 * 
+	 * Tips:
+	 *	Resolved through GetMeshByTag of the EMC, which caches the result for each tag.
+	 */
+	USkeletalMeshComponent* GetMeshByTag(FGameplayTag MeshTypeTag) const;
+
+};
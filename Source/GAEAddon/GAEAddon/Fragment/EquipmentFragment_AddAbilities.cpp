@@ -18,62 +18,64 @@ UEquipmentFragment_AddAbilities::UEquipmentFragment_AddAbilities(const FObjectIn
 }
 
 
-void UEquipmentFragment_AddAbilities::OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilities::OnEquiped(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		auto* ASC{ EMC->GetAbilitySystemComponent() };
+		auto* ASC{ Context.AbilitySystemComponent };
 		check(ASC);
 
-		Instance->GrantAbilitySet_Equip(GrantedGameplayAbilities_OnEquiped, GrantedGameplayEffects_OnEquiped, GrantedAttributes_OnEquiped, ASC);
+		if (GrantTemplate_OnEquiped.IsReady())
+		{
+			Context.Instance->GrantTemplate_Equip(GrantTemplate_OnEquiped, ASC);
+		}
+		else
+		{
+			FScopedEquipmentGrantRecorder Recorder{ GrantTemplate_OnEquiped, ASC, FEquipmentGrantCounts::FromArrays(GrantedGameplayAbilities_OnEquiped, GrantedGameplayEffects_OnEquiped, GrantedAttributes_OnEquiped) };
+
+			Context.Instance->GrantAbilitySet_Equip(GrantedGameplayAbilities_OnEquiped, GrantedGameplayEffects_OnEquiped, GrantedAttributes_OnEquiped, ASC);
+		}
 	}
 }
 
-void UEquipmentFragment_AddAbilities::OnUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilities::OnUnequiped(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		if (auto* ASC{ EMC->GetAbilitySystemComponent() })
+		if (auto* ASC{ Context.AbilitySystemComponent })
 		{
-			Instance->RemoveAbilities_Equip(ASC);
+			Context.Instance->RemoveAbilities_Equip(ASC);
 		}
 	}
 }
 
-void UEquipmentFragment_AddAbilities::OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilities::OnActivated(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		auto* ASC{ EMC->GetAbilitySystemComponent() };
+		auto* ASC{ Context.AbilitySystemComponent };
 		check(ASC);
 
-		Instance->GrantAbilitySet_Equip(GrantedGameplayAbilities_OnActivated, GrantedGameplayEffects_OnActivated, GrantedAttributes_OnActivated, ASC);
+		if (GrantTemplate_OnActivated.IsReady())
+		{
+			Context.Instance->GrantTemplate_Active(GrantTemplate_OnActivated, ASC);
+		}
+		else
+		{
+			FScopedEquipmentGrantRecorder Recorder{ GrantTemplate_OnActivated, ASC, FEquipmentGrantCounts::FromArrays(GrantedGameplayAbilities_OnActivated, GrantedGameplayEffects_OnActivated, GrantedAttributes_OnActivated) };
+
+			Context.Instance->GrantAbilitySet_Active(GrantedGameplayAbilities_OnActivated, GrantedGameplayEffects_OnActivated, GrantedAttributes_OnActivated, ASC);
+		}
 	}
 }
 
-void UEquipmentFragment_AddAbilities::OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilities::OnDeactivated(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		if (auto* ASC{ EMC->GetAbilitySystemComponent() })
+		if (auto* ASC{ Context.AbilitySystemComponent })
 		{
-			Instance->RemoveAbilities_Active(ASC);
+			Context.Instance->RemoveAbilities_Active(ASC);
 		}
 	}
 }
@@ -4,6 +4,8 @@
 
 #include "Fragment/EquipmentFragmentBase.h"
 
+#include "Grant/EquipmentGrantTemplate.h"
+
 #include "EquipmentFragment_AddAbilities.generated.h"
 
 class UAbilitySet;
@@ -13,7 +15,7 @@ class UAbilitySet;
 /**
  * Class that defines the abilities granted to a character when equiping or activating equipment
  */
-UCLASS(meta = (DisplayName = "EF Add Abilities"))
+UCLASS(MinimalAPI, meta = (DisplayName = "EF Add Abilities"))
 class UEquipmentFragment_AddAbilities : public UEquipmentFragmentBase
 {
 	GENERATED_BODY()
@@ -58,11 +60,22 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Activated", meta = (TitleProperty = AttributeSet))
 	TArray<FAbilitySet_AttributeSet> GrantedAttributes_OnActivated;
 
+protected:
+	//
+	// Grants recorded from the first equip, cloned for later equips
+	//
+	mutable FEquipmentGrantTemplate GrantTemplate_OnEquiped;
+
+	//
+	// Grants recorded from the first activation, cloned for later activations
+	//
+	mutable FEquipmentGrantTemplate GrantTemplate_OnActivated;
+
 
 public:
-	virtual void OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
+	virtual void OnEquiped(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnUnequiped(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnActivated(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnDeactivated(const FEquipmentFragmentContext& Context) const override;
 
 };
@@ -18,68 +18,83 @@ UEquipmentFragment_AddAbilitySets::UEquipmentFragment_AddAbilitySets(const FObje
 }
 
 
-void UEquipmentFragment_AddAbilitySets::OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+FEquipmentGrantCounts UEquipmentFragment_AddAbilitySets::GetExpectedCounts(const TArray<TObjectPtr<const UAbilitySet>>& AbilitySets)
 {
-	check(EMC);
-	check(Instance);
+	FEquipmentGrantCounts Counts;
 
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	for (const auto& AbilitySet : AbilitySets)
 	{
-		auto* ASC{ EMC->GetAbilitySystemComponent() };
+		Counts += FEquipmentGrantCounts::FromAbilitySet(AbilitySet);
+	}
+
+	return Counts;
+}
+
+
+void UEquipmentFragment_AddAbilitySets::OnEquiped(const FEquipmentFragmentContext& Context) const
+{
+	if (Context.bHasAuthority)
+	{
+		auto* ASC{ Context.AbilitySystemComponent };
 		check(ASC);
 
-		for (const auto& AbilitySet : AbilitySetsToGrantOnEquip)
+		if (GrantTemplate_OnEquip.IsReady())
+		{
+			Context.Instance->GrantTemplate_Equip(GrantTemplate_OnEquip, ASC);
+		}
+		else
 		{
-			Instance->GrantAbilitySet_Equip(AbilitySet, ASC);
+			FScopedEquipmentGrantRecorder Recorder{ GrantTemplate_OnEquip, ASC, GetExpectedCounts(AbilitySetsToGrantOnEquip) };
+
+			for (const auto& AbilitySet : AbilitySetsToGrantOnEquip)
+			{
+				Context.Instance->GrantAbilitySet_Equip(AbilitySet, ASC);
+			}
 		}
 	}
 }
 
-void UEquipmentFragment_AddAbilitySets::OnUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilitySets::OnUnequiped(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		if (auto* ASC{ EMC->GetAbilitySystemComponent() })
+		if (auto* ASC{ Context.AbilitySystemComponent })
 		{
-			Instance->RemoveAbilities_Equip(ASC);
+			Context.Instance->RemoveAbilities_Equip(ASC);
 		}
 	}
 }
 
-void UEquipmentFragment_AddAbilitySets::OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilitySets::OnActivated(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		auto* ASC{ EMC->GetAbilitySystemComponent() };
+		auto* ASC{ Context.AbilitySystemComponent };
 		check(ASC);
 
-		for (const auto& AbilitySet : AbilitySetsToGrantOnActive)
+		if (GrantTemplate_OnActive.IsReady())
 		{
-			Instance->GrantAbilitySet_Active(AbilitySet, ASC);
+			Context.Instance->GrantTemplate_Active(GrantTemplate_OnActive, ASC);
+		}
+		else
+		{
+			FScopedEquipmentGrantRecorder Recorder{ GrantTemplate_OnActive, ASC, GetExpectedCounts(AbilitySetsToGrantOnActive) };
+
+			for (const auto& AbilitySet : AbilitySetsToGrantOnActive)
+			{
+				Context.Instance->GrantAbilitySet_Active(AbilitySet, ASC);
+			}
 		}
 	}
 }
 
-void UEquipmentFragment_AddAbilitySets::OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_AddAbilitySets::OnDeactivated(const FEquipmentFragmentContext& Context) const
 {
-	check(EMC);
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
-		if (auto* ASC{ EMC->GetAbilitySystemComponent() })
+		if (auto* ASC{ Context.AbilitySystemComponent })
 		{
-			Instance->RemoveAbilities_Active(ASC);
+			Context.Instance->RemoveAbilities_Active(ASC);
 		}
 	}
 }
@@ -4,6 +4,8 @@
 
 #include "Fragment/EquipmentFragmentBase.h"
 
+#include "Grant/EquipmentGrantTemplate.h"
+
 #include "EquipmentFragment_AddAbilitySets.generated.h"
 
 class UAbilitySet;
@@ -33,10 +35,26 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "AddAbilitySets")
 	TArray<TObjectPtr<const UAbilitySet>> AbilitySetsToGrantOnActive;
 
+protected:
+	//
+	// Grants of all AbilitySetsToGrantOnEquip recorded from the first equip, cloned for later equips
+	//
+	mutable FEquipmentGrantTemplate GrantTemplate_OnEquip;
+
+	//
+	// Grants of all AbilitySetsToGrantOnActive recorded from the first activation, cloned for later activations
+	//
+	mutable FEquipmentGrantTemplate GrantTemplate_OnActive;
+
+	/**
+	 * Returns the number of grants expected from the AbilitySets
+	 */
+	static FEquipmentGrantCounts GetExpectedCounts(const TArray<TObjectPtr<const UAbilitySet>>& AbilitySets);
+
 public:
-	virtual void OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnUnequiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
+	virtual void OnEquiped(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnUnequiped(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnActivated(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnDeactivated(const FEquipmentFragmentContext& Context) const override;
 
 };
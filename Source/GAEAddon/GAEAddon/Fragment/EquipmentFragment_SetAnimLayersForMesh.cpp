@@ -6,12 +6,11 @@
 
 #include "EquipmentManagerComponent.h"
 #include "EquipmentInstance.h"
+#include "EquipmentData.h"
 
-#include "Character/CharacterMeshAccessorInterface.h"
-
-#include "GameFramework/Pawn.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
+#include "Engine/AssetManagerTypes.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentFragment_SetAnimLayersForMesh)
 
@@ -21,41 +20,70 @@ UEquipmentFragment_SetAnimLayersForMesh::UEquipmentFragment_SetAnimLayersForMesh
 {
 }
 
+void UEquipmentFragment_SetAnimLayersForMesh::PostLoad()
+{
+	Super::PostLoad();
+
+	// Move the deprecated hard references into the soft references
+
+	for (const auto& KVP : AnimLayerToApply)
+	{
+		if (KVP.Value && !AnimLayersToApply.Contains(KVP.Key))
+		{
+			AnimLayersToApply.Add(KVP.Key, KVP.Value.Get());
+		}
+	}
+
+	AnimLayerToApply.Empty();
+}
 
-void UEquipmentFragment_SetAnimLayersForMesh::OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+#if WITH_EDITORONLY_DATA
+void UEquipmentFragment_SetAnimLayersForMesh::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
 {
-	Super::OnActivated(EMC, Instance);
+	for (const auto& KVP : AnimLayersToApply)
+	{
+		if (!KVP.Value.IsNull())
+		{
+			AssetBundleData.AddBundleAsset(UEquipmentData::NAME_EquipmentBundle, KVP.Value.ToSoftObjectPath().GetAssetPath());
+		}
+	}
+}
+#endif
 
-	check(Instance);
 
-	auto* Pawn{ Instance->GetPawn<APawn>() };
+void UEquipmentFragment_SetAnimLayersForMesh::OnActivated(const FEquipmentFragmentContext& Context) const
+{
+	Super::OnActivated(Context);
 
-	for (const auto& KVP : AnimLayerToApply)
+	auto* Instance{ Context.Instance };
+
+	for (const auto& KVP : AnimLayersToApply)
 	{
 		const auto& Tag{ KVP.Key };
-		const auto& Class{ KVP.Value };
+
+		// Already loaded if the asset bundle has been preloaded
+
+		TSubclassOf<UAnimInstance> Class{ KVP.Value.LoadSynchronous() };
 
 		if (!Class)
 		{
 			continue;
 		}
 
-		UE_LOG(LogGAEA, Log, TEXT("+ To [%s](Class:%s)")
+		GAEALIFECYCLELOG(Instance, TEXT("+ To [%s](Class:%s)")
 			, *Tag.GetTagName().ToString()
 			, *GetNameSafe(Class));
 
-		if (auto* Mesh{ ICharacterMeshAccessorInterface::Execute_GetMeshByTag(Pawn, Tag) })
+		if (auto* Mesh{ Context.GetMeshByTag(Tag) })
 		{
 			Instance->ApplyAnimLayer(Mesh, Class);
 		}
 	}
 }
 
-void UEquipmentFragment_SetAnimLayersForMesh::OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_SetAnimLayersForMesh::OnDeactivated(const FEquipmentFragmentContext& Context) const
 {
-	Super::OnDeactivated(EMC, Instance);
-
-	check(Instance);
+	Super::OnDeactivated(Context);
 
-	Instance->RemoveAnimLayers();
+	Context.Instance->RemoveAnimLayers();
 }
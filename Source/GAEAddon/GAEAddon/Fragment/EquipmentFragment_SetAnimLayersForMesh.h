@@ -21,15 +21,38 @@ class UEquipmentFragment_SetAnimLayersForMesh : public UEquipmentFragmentBase
 public:
 	UEquipmentFragment_SetAnimLayersForMesh(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITORONLY_DATA
+	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
+#endif
+
 public:
 	//
 	// AnimLayer class that adapts to the Pawn's Mesh when Equipment is Active.
+	// 
+	// Tips:
+	//	Loaded with the "Equipment" asset bundle when bPreloadEquipmentBundles of EquipmentManagerComponent is enabled.
+	//	Otherwise it is loaded synchronously when the Equipment is activated.
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "SetAnimLayers", meta = (ForceInlineRow, Categories = "MeshType", AssetBundles = "Equipment"))
+	TMap<FGameplayTag, TSoftClassPtr<UAnimInstance>> AnimLayersToApply;
+
+protected:
+	//
+	// Hard references to the AnimLayer classes, replaced by AnimLayersToApply
+	// 
+	// Note:
+	//	Kept so that saved data keeps working. Saved values are moved into AnimLayersToApply on load.
 	//
-	UPROPERTY(EditDefaultsOnly, Category = "SetAnimLayers", meta = (ForceInlineRow, Categories = "MeshType"))
+	UPROPERTY()
 	TMap<FGameplayTag, TSubclassOf<UAnimInstance>> AnimLayerToApply;
 
 public:
-	virtual void OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
+	virtual EEquipmentFragmentPhase GetHandledPhases() const override { return EEquipmentFragmentPhase::Activated | EEquipmentFragmentPhase::Deactivated; }
+	virtual bool RequiresEquipmentBundle() const override { return true; }
+
+	virtual void OnActivated(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnDeactivated(const FEquipmentFragmentContext& Context) const override;
 
 };
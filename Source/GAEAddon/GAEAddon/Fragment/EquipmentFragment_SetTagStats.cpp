@@ -14,19 +14,16 @@ UEquipmentFragment_SetTagStats::UEquipmentFragment_SetTagStats(const FObjectInit
 }
 
 
-void UEquipmentFragment_SetTagStats::OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_SetTagStats::OnEquiped(const FEquipmentFragmentContext& Context) const
 {
-	check(Instance);
-
-	auto* Pawn{ Instance->GetPawnChecked<APawn>() };
-	if (Pawn->HasAuthority())
+	if (Context.bHasAuthority)
 	{
 		for (const auto& KVP : InitialEquipmentStats)
 		{
 			const auto& Tag{ KVP.Key };
 			const auto& Count{ KVP.Value };
 
-			Instance->AddStatTagStack(Tag, Count);
+			Context.Instance->AddStatTagStack(Tag, Count);
 		}
 	}
 }
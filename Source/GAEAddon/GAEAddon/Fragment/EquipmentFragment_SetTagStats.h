@@ -27,6 +27,8 @@ public:
 	TMap<FGameplayTag, int32> InitialEquipmentStats;
 
 public:
-	virtual void OnEquiped(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
+	virtual EEquipmentFragmentPhase GetHandledPhases() const override { return EEquipmentFragmentPhase::Equiped; }
+
+	virtual void OnEquiped(const FEquipmentFragmentContext& Context) const override;
 
 };
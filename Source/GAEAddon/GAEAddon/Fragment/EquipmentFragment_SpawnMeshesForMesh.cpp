@@ -6,10 +6,9 @@
 
 #include "EquipmentManagerComponent.h"
 #include "EquipmentInstance.h"
+#include "EquipmentData.h"
 
-#include "Character/CharacterMeshAccessorInterface.h"
-
-#include "GameFramework/Pawn.h"
+#include "Engine/AssetManagerTypes.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentFragment_SpawnMeshesForMesh)
 
@@ -19,17 +18,33 @@ UEquipmentFragment_SpawnMeshesForMesh::UEquipmentFragment_SpawnMeshesForMesh(con
 {
 }
 
-
-void UEquipmentFragment_SpawnMeshesForMesh::OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+#if WITH_EDITORONLY_DATA
+void UEquipmentFragment_SpawnMeshesForMesh::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
 {
-	Super::OnActivated(EMC, Instance);
+	for (const auto& SpawnInfo : MeshesToSpawn)
+	{
+		if (!SpawnInfo.Mesh.IsNull())
+		{
+			AssetBundleData.AddBundleAsset(UEquipmentData::NAME_EquipmentBundle, SpawnInfo.Mesh.ToSoftObjectPath().GetAssetPath());
+		}
+
+		if (!SpawnInfo.AnimClass.IsNull())
+		{
+			AssetBundleData.AddBundleAsset(UEquipmentData::NAME_EquipmentBundle, SpawnInfo.AnimClass.ToSoftObjectPath().GetAssetPath());
+		}
+	}
+}
+#endif
 
-	check(Instance);
 
-	auto* Pawn{ Instance->GetPawn<APawn>() };
-	const auto bLocallyControlled{ Pawn->IsLocallyControlled() };
+void UEquipmentFragment_SpawnMeshesForMesh::OnActivated(const FEquipmentFragmentContext& Context) const
+{
+	Super::OnActivated(Context);
+
+	auto* Instance{ Context.Instance };
+	const auto bLocallyControlled{ Context.bIsLocallyControlled };
 
-	UE_LOG(LogGAEA, Log, TEXT("+ Add (%d) Meshes to (%d) components"), MeshesToSpawn.Num(), ComponentToAdd.Num());
+	GAEALIFECYCLELOG(Instance, TEXT("+ Add (%d) Meshes to (%d) components"), MeshesToSpawn.Num(), ComponentToAdd.Num());
 
 	for (const auto& Entry : ComponentToAdd)
 	{
@@ -38,7 +53,7 @@ void UEquipmentFragment_SpawnMeshesForMesh::OnActivated(UEquipmentManagerCompone
 			(bLocallyControlled && Entry.bAddToOwner) || (!bLocallyControlled && Entry.bAddToOther)
 		};
 
-		UE_LOG(LogGAEA, Log, TEXT("++ To [%s](bAddToOwner:%s, bAddToOther:%s, bCanAdd:%s)")
+		GAEALIFECYCLELOG(Instance, TEXT("++ To [%s](bAddToOwner:%s, bAddToOther:%s, bCanAdd:%s)")
 			, *Entry.MeshTypeTag.GetTagName().ToString()
 			, Entry.bAddToOwner ? TEXT("TRUE") : TEXT("FALSE")
 			, Entry.bAddToOther ? TEXT("TRUE") : TEXT("FALSE")
@@ -46,7 +61,7 @@ void UEquipmentFragment_SpawnMeshesForMesh::OnActivated(UEquipmentManagerCompone
 
 		if (bCanAdd)
 		{
-			if (auto* Mesh{ ICharacterMeshAccessorInterface::Execute_GetMeshByTag(Pawn, Entry.MeshTypeTag) })
+			if (auto* Mesh{ Context.GetMeshByTag(Entry.MeshTypeTag) })
 			{
 				Instance->SpawnEquipmentMeshes(Mesh, MeshesToSpawn);
 			}
@@ -54,11 +69,9 @@ void UEquipmentFragment_SpawnMeshesForMesh::OnActivated(UEquipmentManagerCompone
 	}
 }
 
-void UEquipmentFragment_SpawnMeshesForMesh::OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const
+void UEquipmentFragment_SpawnMeshesForMesh::OnDeactivated(const FEquipmentFragmentContext& Context) const
 {
-	Super::OnDeactivated(EMC, Instance);
-
-	check(Instance);
+	Super::OnDeactivated(Context);
 
-	Instance->DestroyEquipmentMeshes();
+	Context.Instance->DestroyEquipmentMeshes();
 }
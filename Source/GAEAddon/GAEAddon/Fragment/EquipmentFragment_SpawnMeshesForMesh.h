@@ -44,6 +44,10 @@ class UEquipmentFragment_SpawnMeshesForMesh : public UEquipmentFragmentBase
 public:
 	UEquipmentFragment_SpawnMeshesForMesh(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+#if WITH_EDITORONLY_DATA
+	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
+#endif
+
 public:
 	//
 	// Definition of SkeletalMesh, which is the appearance of the equipment
@@ -58,7 +62,10 @@ public:
 	TArray<FMeshComponentToAddEquipment> ComponentToAdd;
 
 public:
-	virtual void OnActivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
-	virtual void OnDeactivated(UEquipmentManagerComponent* EMC, UEquipmentInstance* Instance) const override;
+	virtual EEquipmentFragmentPhase GetHandledPhases() const override { return EEquipmentFragmentPhase::Activated | EEquipmentFragmentPhase::Deactivated; }
+	virtual bool RequiresEquipmentBundle() const override { return true; }
+
+	virtual void OnActivated(const FEquipmentFragmentContext& Context) const override;
+	virtual void OnDeactivated(const FEquipmentFragmentContext& Context) const override;
 
 };
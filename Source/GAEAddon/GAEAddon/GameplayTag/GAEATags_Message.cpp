@@ -8,3 +8,4 @@
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Message_Equipment_SlotChange					, "Message.Equipment.SlotChange");
 UE_DEFINE_GAMEPLAY_TAG(TAG_Message_Equipment_ActiveSlotChange			, "Message.Equipment.ActiveSlotChange");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Message_Equipment_SlotsChange				, "Message.Equipment.SlotsChange");
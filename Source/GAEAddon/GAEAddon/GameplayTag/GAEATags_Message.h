@@ -10,3 +10,4 @@
 
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Message_Equipment_SlotChange);
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Message_Equipment_ActiveSlotChange);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Message_Equipment_SlotsChange);
@@ -0,0 +1,156 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentGrantQueueSubsystem.h"
+
+#include "EquipmentManagerComponent.h"
+#include "GAEAddonLogs.h"
+#include "GAEAddonStats.h"
+
+#include "Engine/World.h"
+#include "Algo/Count.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentGrantQueueSubsystem)
+
+
+namespace EquipmentGrantQueueCVars
+{
+	static bool bEnableGrantQueue{ false };
+	static FAutoConsoleVariableRef CVarEnableGrantQueue(
+		TEXT("GAEA.Equipment.GrantQueue.Enable"),
+		bEnableGrantQueue,
+		TEXT("Whether the initial equipment sets of EquipmentManagerComponents are applied spread across frames on the server."),
+		ECVF_Default);
+
+	static float GrantBudgetMs{ 2.0f };
+	static FAutoConsoleVariableRef CVarGrantBudgetMs(
+		TEXT("GAEA.Equipment.GrantQueue.BudgetMs"),
+		GrantBudgetMs,
+		TEXT("Time (ms) per frame that can be spent applying queued initial equipment sets."),
+		ECVF_Default);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// UEquipmentGrantQueueSubsystem
+
+#pragma region UEquipmentGrantQueueSubsystem
+
+void UEquipmentGrantQueueSubsystem::Deinitialize()
+{
+	PendingComponents.Reset();
+
+	Super::Deinitialize();
+}
+
+void UEquipmentGrantQueueSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingComponents.IsEmpty())
+	{
+		return;
+	}
+
+	GAEA_SCOPE_CYCLE_COUNTER("ProcessGrantQueue", STAT_GAEA_ProcessGrantQueue);
+
+	const auto StartTime{ FPlatformTime::Seconds() };
+	const auto BudgetSeconds{ FMath::Max(EquipmentGrantQueueCVars::GrantBudgetMs, 0.0f) / 1000.0 };
+
+	auto NumProcessed{ 0 };
+	auto NumApplied{ 0 };
+
+	// Entries are only cleared while processing (see DequeueComponent), so the index stays valid
+	// even if components are dequeued or enqueued by ApplyQueuedInitialEquipmentSet.
+	// Components enqueued during processing are appended and processed in this loop if the budget allows
+
+	while (NumProcessed < PendingComponents.Num())
+	{
+		auto* Component{ PendingComponents[NumProcessed].Get() };
+
+		// Skip components that have been dequeued or destroyed
+
+		if (!IsValid(Component))
+		{
+			++NumProcessed;
+			continue;
+		}
+
+		// Always apply at least one component so that the queue drains
+
+		if ((NumApplied > 0) && ((FPlatformTime::Seconds() - StartTime) >= BudgetSeconds))
+		{
+			break;
+		}
+
+		// Clear the entry before applying, so that the component can enqueue itself again while being applied
+
+		PendingComponents[NumProcessed].Reset();
+
+		++NumProcessed;
+		++NumApplied;
+
+		Component->ApplyQueuedInitialEquipmentSet();
+	}
+
+	PendingComponents.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+
+	UE_LOG(LogGAEA, Verbose, TEXT("EquipmentGrantQueue: Applied %d components, %d pending."), NumApplied, GetNumPendingComponents());
+}
+
+TStatId UEquipmentGrantQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEquipmentGrantQueueSubsystem, STATGROUP_Tickables);
+}
+
+
+void UEquipmentGrantQueueSubsystem::EnqueueComponent(UEquipmentManagerComponent* Component)
+{
+	if (IsValid(Component))
+	{
+		PendingComponents.AddUnique(Component);
+	}
+}
+
+void UEquipmentGrantQueueSubsystem::DequeueComponent(UEquipmentManagerComponent* Component)
+{
+	// Only clear the entry, since this can be called from Tick while the queue is being processed
+
+	const auto Index{ PendingComponents.IndexOfByKey(Component) };
+
+	if (Index != INDEX_NONE)
+	{
+		PendingComponents[Index].Reset();
+	}
+}
+
+int32 UEquipmentGrantQueueSubsystem::GetNumPendingComponents() const
+{
+	return Algo::CountIf(PendingComponents, [](const TWeakObjectPtr<UEquipmentManagerComponent>& Component) { return Component.IsValid(); });
+}
+
+
+bool UEquipmentGrantQueueSubsystem::IsQueueEnabled()
+{
+	return EquipmentGrantQueueCVars::bEnableGrantQueue;
+}
+
+bool UEquipmentGrantQueueSubsystem::EnqueueComponentFor(UEquipmentManagerComponent* Component)
+{
+	if (!IsQueueEnabled() || !Component)
+	{
+		return false;
+	}
+
+	auto* World{ Component->GetWorld() };
+
+	if (auto* Subsystem{ World ? World->GetSubsystem<UEquipmentGrantQueueSubsystem>() : nullptr })
+	{
+		Subsystem->EnqueueComponent(Component);
+		return true;
+	}
+
+	return false;
+}
+
+#pragma endregion
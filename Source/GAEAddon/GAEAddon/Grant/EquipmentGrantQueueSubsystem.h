@@ -0,0 +1,71 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "EquipmentGrantQueueSubsystem.generated.h"
+
+class UEquipmentManagerComponent;
+
+
+/**
+ * Subsystem that applies the initial equipment sets of EquipmentManagerComponents on the server
+ * spread across frames within a time budget per frame.
+ *
+ * Tips:
+ *	Queueing is disabled by default and can be enabled with "GAEA.Equipment.GrantQueue.Enable".
+ *	The time budget per frame can be changed with "GAEA.Equipment.GrantQueue.BudgetMs".
+ *
+ * Note:
+ *	At least one component is processed per frame, and the initial equipment set of a component is always applied at once.
+ *	Attribute aggregation is evaluated once per set (see ApplyInitialEquipmentSet), but the effects themselves are applied one by one.
+ */
+UCLASS()
+class GAEADDON_API UEquipmentGrantQueueSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	UEquipmentGrantQueueSubsystem() {}
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	//
+	// Components waiting for their initial equipment set to be applied, in order of request
+	// 
+	// Note:
+	//	Entries of dequeued components are cleared instead of removed and are skipped in Tick.
+	//
+	TArray<TWeakObjectPtr<UEquipmentManagerComponent>> PendingComponents;
+
+public:
+	/**
+	 * Adds the component to the queue.
+	 * The component is notified by ApplyQueuedInitialEquipmentSet when its turn comes.
+	 */
+	void EnqueueComponent(UEquipmentManagerComponent* Component);
+
+	/**
+	 * Removes the component from the queue without applying
+	 */
+	void DequeueComponent(UEquipmentManagerComponent* Component);
+
+	/**
+	 * Returns the number of components still waiting, excluding dequeued ones
+	 */
+	int32 GetNumPendingComponents() const;
+
+public:
+	static bool IsQueueEnabled();
+
+	/**
+	 * Adds the component to the queue of the world to which it belongs.
+	 * Returns false if queueing is disabled or not available.
+	 */
+	static bool EnqueueComponentFor(UEquipmentManagerComponent* Component);
+
+};
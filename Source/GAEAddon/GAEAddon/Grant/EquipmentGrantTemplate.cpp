@@ -0,0 +1,357 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentGrantTemplate.h"
+
+#include "GAEAddonLogs.h"
+#include "GAEAddonStats.h"
+
+#include "AbilitySet.h"
+
+#include "AbilitySystemComponent.h"
+#include "AttributeSet.h"
+
+#include "Algo/Count.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+
+#if WITH_EDITOR
+#include "Misc/DelayedAutoRegister.h"
+#include "UObject/UObjectGlobals.h"
+#endif // WITH_EDITOR
+
+
+namespace EquipmentGrantTemplateCVars
+{
+	static bool bEnableGrantTemplate{ true };
+	static FAutoConsoleVariableRef CVarEnableGrantTemplate(
+		TEXT("GAEA.Equipment.GrantTemplate.Enable"),
+		bEnableGrantTemplate,
+		TEXT("Whether ability fragments clone their grants from a template recorded on the first grant instead of building them for each pawn."),
+		ECVF_Default);
+}
+
+
+namespace EquipmentGrantTemplate
+{
+#if WITH_EDITOR
+	//
+	// Incremented whenever a property is edited, since any edited ability, effect or AbilitySet may change what is granted
+	//
+	static uint32 EditorGeneration{ 0 };
+
+	static FDelayedAutoRegisterHelper RegisterEditorGeneration(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+		{
+			FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject*, FPropertyChangedEvent&)
+				{
+					++EditorGeneration;
+				});
+		});
+#endif // WITH_EDITOR
+
+	/**
+	 * Returns the number of entries of the struct type in the array properties of the object whose class is set
+	 */
+	template<typename EntryType, typename PredicateType>
+	static int32 CountEntriesInObject(const UObject* Object, PredicateType&& IsValidEntry)
+	{
+		auto Count{ 0 };
+
+		for (TFieldIterator<FArrayProperty> It(Object->GetClass()); It; ++It)
+		{
+			const auto* Inner{ CastField<FStructProperty>(It->Inner) };
+			if (!Inner || (Inner->Struct != EntryType::StaticStruct()))
+			{
+				continue;
+			}
+
+			FScriptArrayHelper Helper(*It, It->ContainerPtrToValuePtr<void>(Object));
+
+			for (auto Index{ 0 }; Index < Helper.Num(); ++Index)
+			{
+				if (IsValidEntry(*reinterpret_cast<const EntryType*>(Helper.GetRawPtr(Index))))
+				{
+					++Count;
+				}
+			}
+		}
+
+		return Count;
+	}
+
+	static bool IsValidAbility(const FAbilitySet_GameplayAbility& Entry) { return Entry.Ability.Get() != nullptr; }
+	static bool IsValidEffect(const FAbilitySet_GameplayEffect& Entry) { return Entry.GameplayEffect.Get() != nullptr; }
+	static bool IsValidAttributeSet(const FAbilitySet_AttributeSet& Entry) { return Entry.AttributeSet.Get() != nullptr; }
+}
+
+
+#pragma region Counts
+
+FEquipmentGrantCounts FEquipmentGrantCounts::FromArrays(const TArray<FAbilitySet_GameplayAbility>& Abilities, const TArray<FAbilitySet_GameplayEffect>& Effects, const TArray<FAbilitySet_AttributeSet>& Sets)
+{
+	using namespace EquipmentGrantTemplate;
+
+	FEquipmentGrantCounts Counts;
+	Counts.NumAbilities = Algo::CountIf(Abilities, &IsValidAbility);
+	Counts.NumEffects = Algo::CountIf(Effects, &IsValidEffect);
+	Counts.NumAttributeSets = Algo::CountIf(Sets, &IsValidAttributeSet);
+
+	return Counts;
+}
+
+FEquipmentGrantCounts FEquipmentGrantCounts::FromAbilitySet(const UAbilitySet* AbilitySet)
+{
+	using namespace EquipmentGrantTemplate;
+
+	FEquipmentGrantCounts Counts;
+
+	// UAbilitySet keeps its entries in array properties, which are found by their struct type
+
+	if (AbilitySet)
+	{
+		Counts.NumAbilities = CountEntriesInObject<FAbilitySet_GameplayAbility>(AbilitySet, &IsValidAbility);
+		Counts.NumEffects = CountEntriesInObject<FAbilitySet_GameplayEffect>(AbilitySet, &IsValidEffect);
+		Counts.NumAttributeSets = CountEntriesInObject<FAbilitySet_AttributeSet>(AbilitySet, &IsValidAttributeSet);
+	}
+
+	return Counts;
+}
+
+FEquipmentGrantCounts& FEquipmentGrantCounts::operator+=(const FEquipmentGrantCounts& Other)
+{
+	NumAbilities += Other.NumAbilities;
+	NumEffects += Other.NumEffects;
+	NumAttributeSets += Other.NumAttributeSets;
+
+	return *this;
+}
+
+bool FEquipmentGrantCounts::operator==(const FEquipmentGrantCounts& Other) const
+{
+	return (NumAbilities == Other.NumAbilities) && (NumEffects == Other.NumEffects) && (NumAttributeSets == Other.NumAttributeSets);
+}
+
+#pragma endregion
+
+
+#pragma region Handles
+
+bool FEquipmentTemplateGrantedHandles::IsEmpty() const
+{
+	return AbilitySpecHandles.IsEmpty() && GameplayEffectHandles.IsEmpty() && GrantedAttributeSets.IsEmpty();
+}
+
+void FEquipmentTemplateGrantedHandles::TakeFromAbilitySystem(UAbilitySystemComponent* ASC)
+{
+	check(ASC);
+
+	for (const auto& Handle : AbilitySpecHandles)
+	{
+		if (Handle.IsValid())
+		{
+			ASC->ClearAbility(Handle);
+		}
+	}
+
+	for (const auto& Handle : GameplayEffectHandles)
+	{
+		if (Handle.IsValid())
+		{
+			ASC->RemoveActiveGameplayEffect(Handle);
+		}
+	}
+
+	for (const auto& WeakSet : GrantedAttributeSets)
+	{
+		if (auto* Set{ WeakSet.Get() })
+		{
+			ASC->RemoveSpawnedAttribute(Set);
+		}
+	}
+
+	AbilitySpecHandles.Reset();
+	GameplayEffectHandles.Reset();
+	GrantedAttributeSets.Reset();
+}
+
+#pragma endregion
+
+
+#pragma region Template
+
+bool FEquipmentGrantTemplate::IsEnabled()
+{
+	return EquipmentGrantTemplateCVars::bEnableGrantTemplate;
+}
+
+bool FEquipmentGrantTemplate::IsReady() const
+{
+#if WITH_EDITOR
+	if (RecordedGeneration != EquipmentGrantTemplate::EditorGeneration)
+	{
+		return false;
+	}
+#endif // WITH_EDITOR
+
+	return bRecorded && IsEnabled();
+}
+
+void FEquipmentGrantTemplate::Reset()
+{
+	AbilitySpecs.Reset();
+	Effects.Reset();
+	AttributeSetClasses.Reset();
+
+	bRecorded = false;
+}
+
+void FEquipmentGrantTemplate::GrantTo(UAbilitySystemComponent* ASC, UObject* SourceObject, FEquipmentTemplateGrantedHandles& OutHandles) const
+{
+	GAEA_SCOPE_CYCLE_COUNTER("GrantTemplate", STAT_GAEA_GrantTemplate);
+
+	check(ASC);
+	check(IsReady());
+
+	for (const auto& SpecTemplate : AbilitySpecs)
+	{
+		auto Spec{ SpecTemplate };
+		Spec.Handle.GenerateNewHandle();
+		Spec.SourceObject = SourceObject;
+
+		OutHandles.AbilitySpecHandles.Add(ASC->GiveAbility(Spec));
+	}
+
+	for (const auto& Effect : Effects)
+	{
+		auto EffectContext{ ASC->MakeEffectContext() };
+		EffectContext.AddSourceObject(SourceObject);
+
+		const auto Handle{ ASC->ApplyGameplayEffectToSelf(Effect.Definition, Effect.Level, EffectContext) };
+
+		if (Handle.IsValid())
+		{
+			OutHandles.GameplayEffectHandles.Add(Handle);
+		}
+	}
+
+	for (const auto& SetClass : AttributeSetClasses)
+	{
+		auto* NewSet{ NewObject<UAttributeSet>(ASC->GetOwner(), SetClass) };
+		ASC->AddAttributeSetSubobject(NewSet);
+
+		OutHandles.GrantedAttributeSets.Add(NewSet);
+	}
+}
+
+#pragma endregion
+
+
+#pragma region Recorder
+
+FScopedEquipmentGrantRecorder::FScopedEquipmentGrantRecorder(FEquipmentGrantTemplate& InTemplate, UAbilitySystemComponent* InASC, const FEquipmentGrantCounts& InExpectedCounts)
+{
+	if (!InASC || InTemplate.IsReady() || !FEquipmentGrantTemplate::IsEnabled())
+	{
+		return;
+	}
+
+	Template = &InTemplate;
+	ASC = InASC;
+	ExpectedCounts = InExpectedCounts;
+
+	for (const auto& Spec : ASC->GetActivatableAbilities())
+	{
+		AbilitiesBefore.Add(Spec.Handle);
+	}
+
+	for (const auto* Set : ASC->GetSpawnedAttributes())
+	{
+		AttributeSetsBefore.Add(Set);
+	}
+
+	EffectAppliedHandle = ASC->OnGameplayEffectAppliedDelegateToSelf.AddRaw(this, &FScopedEquipmentGrantRecorder::HandleEffectApplied);
+}
+
+FScopedEquipmentGrantRecorder::~FScopedEquipmentGrantRecorder()
+{
+	if (!Template)
+	{
+		return;
+	}
+
+	ASC->OnGameplayEffectAppliedDelegateToSelf.Remove(EffectAppliedHandle);
+
+	// Collect what the grant added
+
+	TArray<FGameplayAbilitySpec> NewSpecs;
+
+	for (const auto& Spec : ASC->GetActivatableAbilities())
+	{
+		if (!AbilitiesBefore.Contains(Spec.Handle))
+		{
+			NewSpecs.Add(Spec);
+		}
+	}
+
+	TArray<TSubclassOf<UAttributeSet>> NewSetClasses;
+
+	for (const auto* Set : ASC->GetSpawnedAttributes())
+	{
+		if (Set && !AttributeSetsBefore.Contains(Set))
+		{
+			NewSetClasses.Add(Set->GetClass());
+		}
+	}
+
+	FEquipmentGrantCounts RecordedCounts;
+	RecordedCounts.NumAbilities = NewSpecs.Num();
+	RecordedCounts.NumEffects = AppliedEffects.Num();
+	RecordedCounts.NumAttributeSets = NewSetClasses.Num();
+
+	if (RecordedCounts != ExpectedCounts)
+	{
+		UE_LOG(LogGAEA, Verbose, TEXT("Grant template was not recorded from %s: granted (%d, %d, %d), expected (%d, %d, %d)"),
+			*GetNameSafe(ASC->GetOwner()),
+			RecordedCounts.NumAbilities, RecordedCounts.NumEffects, RecordedCounts.NumAttributeSets,
+			ExpectedCounts.NumAbilities, ExpectedCounts.NumEffects, ExpectedCounts.NumAttributeSets);
+
+		return;
+	}
+
+	// Keep the specs without the state of the ASC they were granted to
+
+	for (auto& Spec : NewSpecs)
+	{
+		Spec.ReplicationID = INDEX_NONE;
+		Spec.ReplicationKey = INDEX_NONE;
+		Spec.MostRecentArrayReplicationKey = INDEX_NONE;
+
+		Spec.ActiveCount = 0;
+		Spec.InputPressed = false;
+		Spec.RemoveAfterActivation = false;
+		Spec.PendingRemove = false;
+		Spec.bActivateOnce = false;
+		Spec.ReplicatedInstances.Reset();
+		Spec.NonReplicatedInstances.Reset();
+		Spec.GameplayEffectHandle = FActiveGameplayEffectHandle();
+		Spec.GameplayEventData.Reset();
+		Spec.SourceObject = nullptr;
+	}
+
+	Template->AbilitySpecs = MoveTemp(NewSpecs);
+	Template->Effects = MoveTemp(AppliedEffects);
+	Template->AttributeSetClasses = MoveTemp(NewSetClasses);
+	Template->bRecorded = true;
+
+#if WITH_EDITOR
+	Template->RecordedGeneration = EquipmentGrantTemplate::EditorGeneration;
+#endif // WITH_EDITOR
+}
+
+void FScopedEquipmentGrantRecorder::HandleEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	auto& Effect{ AppliedEffects.AddDefaulted_GetRef() };
+	Effect.Definition = Spec.Def;
+	Effect.Level = Spec.GetLevel();
+}
+
+#pragma endregion
@@ -0,0 +1,164 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayAbilitySpec.h"
+#include "ActiveGameplayEffectHandle.h"
+
+class UAbilitySystemComponent;
+class UAbilitySet;
+class UAttributeSet;
+class UGameplayEffect;
+struct FAbilitySet_GameplayAbility;
+struct FAbilitySet_GameplayEffect;
+struct FAbilitySet_AttributeSet;
+struct FGameplayEffectSpec;
+
+
+/**
+ * Number of abilities, effects and attribute sets that a grant is expected to add to an AbilitySystemComponent
+ */
+struct GAEADDON_API FEquipmentGrantCounts
+{
+public:
+	int32 NumAbilities{ 0 };
+	int32 NumEffects{ 0 };
+	int32 NumAttributeSets{ 0 };
+
+public:
+	/**
+	 * Returns the number of entries with a class set in the arrays
+	 */
+	static FEquipmentGrantCounts FromArrays(
+		const TArray<FAbilitySet_GameplayAbility>& Abilities
+		, const TArray<FAbilitySet_GameplayEffect>& Effects
+		, const TArray<FAbilitySet_AttributeSet>& Sets);
+
+	/**
+	 * Returns the number of entries with a class set in the AbilitySet
+	 */
+	static FEquipmentGrantCounts FromAbilitySet(const UAbilitySet* AbilitySet);
+
+	FEquipmentGrantCounts& operator+=(const FEquipmentGrantCounts& Other);
+	bool operator==(const FEquipmentGrantCounts& Other) const;
+	bool operator!=(const FEquipmentGrantCounts& Other) const { return !(*this == Other); }
+
+};
+
+
+/**
+ * Handles of abilities, effects and attribute sets granted from FEquipmentGrantTemplate
+ */
+struct GAEADDON_API FEquipmentTemplateGrantedHandles
+{
+public:
+	TArray<FGameplayAbilitySpecHandle> AbilitySpecHandles;
+	TArray<FActiveGameplayEffectHandle> GameplayEffectHandles;
+	TArray<TWeakObjectPtr<UAttributeSet>> GrantedAttributeSets;
+
+public:
+	bool IsEmpty() const;
+
+	/**
+	 * Removes everything granted from the AbilitySystemComponent and clears the handles
+	 */
+	void TakeFromAbilitySystem(UAbilitySystemComponent* ASC);
+
+};
+
+
+/**
+ * Grants of AbilitySets or ability fragments recorded from their first grant through FAbilitySet_GrantedHandles.
+ * Later grants are cloned from the template instead of being built again for each AbilitySystemComponent.
+ * 
+ * Tips:
+ *	Ability specs keep the resolved ability CDO, level, input and dynamic tags, and only get a new handle and source object.
+ *	Effects keep their definition and level. Their specs are built for each ASC, since they capture its attributes.
+ *	Attribute sets keep their class.
+ * 
+ * Note:
+ *	A recording is only used if it added exactly the expected number of grants.
+ *	Otherwise, for example when an ability was deferred by an ability scope lock, the next grant is recorded again.
+ *	The template does not reference the classes for GC, so the owner must keep them alive, as the fragments do with their properties.
+ *	Enabled with GAEA.Equipment.GrantTemplate.Enable.
+ */
+struct GAEADDON_API FEquipmentGrantTemplate
+{
+	friend class FScopedEquipmentGrantRecorder;
+public:
+	FEquipmentGrantTemplate() {}
+
+protected:
+	struct FEffectTemplate
+	{
+		TObjectPtr<const UGameplayEffect> Definition{ nullptr };
+		float Level{ 1.0f };
+	};
+
+	TArray<FGameplayAbilitySpec> AbilitySpecs;
+	TArray<FEffectTemplate> Effects;
+	TArray<TSubclassOf<UAttributeSet>> AttributeSetClasses;
+
+	bool bRecorded{ false };
+
+#if WITH_EDITOR
+	//
+	// Editor property change generation when recorded, so that edited assets are recorded again
+	//
+	uint32 RecordedGeneration{ 0 };
+#endif // WITH_EDITOR
+
+public:
+	/**
+	 * Returns whether grant templates are enabled
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Returns whether grants can be cloned from this template
+	 */
+	bool IsReady() const;
+
+	/**
+	 * Discards the recorded grants so that the next grant is recorded again
+	 */
+	void Reset();
+
+	/**
+	 * Grants the recorded abilities, effects and attribute sets to the AbilitySystemComponent
+	 */
+	void GrantTo(UAbilitySystemComponent* ASC, UObject* SourceObject, FEquipmentTemplateGrantedHandles& OutHandles) const;
+
+};
+
+
+/**
+ * Records into FEquipmentGrantTemplate the grants made to the AbilitySystemComponent during its scope
+ * 
+ * Tips:
+ *	Does nothing if the template is disabled or already ready.
+ */
+class GAEADDON_API FScopedEquipmentGrantRecorder
+{
+public:
+	FScopedEquipmentGrantRecorder(FEquipmentGrantTemplate& InTemplate, UAbilitySystemComponent* InASC, const FEquipmentGrantCounts& InExpectedCounts);
+	~FScopedEquipmentGrantRecorder();
+
+	FScopedEquipmentGrantRecorder(const FScopedEquipmentGrantRecorder&) = delete;
+	FScopedEquipmentGrantRecorder& operator=(const FScopedEquipmentGrantRecorder&) = delete;
+
+private:
+	FEquipmentGrantTemplate* Template{ nullptr };
+	UAbilitySystemComponent* ASC{ nullptr };
+	FEquipmentGrantCounts ExpectedCounts;
+
+	TSet<FGameplayAbilitySpecHandle> AbilitiesBefore;
+	TSet<const UAttributeSet*> AttributeSetsBefore;
+	TArray<FEquipmentGrantTemplate::FEffectTemplate> AppliedEffects;
+
+	FDelegateHandle EffectAppliedHandle;
+
+private:
+	void HandleEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+
+};
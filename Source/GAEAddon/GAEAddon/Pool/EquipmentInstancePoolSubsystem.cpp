@@ -0,0 +1,213 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentInstancePoolSubsystem.h"
+
+#include "EquipmentInstance.h"
+#include "GAEAddonLogs.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentInstancePoolSubsystem)
+
+
+namespace EquipmentInstancePoolCVars
+{
+	static bool bEnableInstancePool{ false };
+	static FAutoConsoleVariableRef CVarEnableInstancePool(
+		TEXT("GAEA.Equipment.InstancePool.Enable"),
+		bEnableInstancePool,
+		TEXT("Whether EquipmentInstances removed from EquipmentManagerComponent are pooled and reused."),
+		ECVF_Default);
+
+	static int32 MaxPooledInstancesPerType{ 32 };
+	static FAutoConsoleVariableRef CVarMaxPooledInstancesPerType(
+		TEXT("GAEA.Equipment.InstancePool.MaxPerType"),
+		MaxPooledInstancesPerType,
+		TEXT("Maximum number of EquipmentInstances pooled for each InstanceType in a world."),
+		ECVF_Default);
+
+	static void DumpInstancePool(UWorld* World)
+	{
+		if (auto* Subsystem{ World ? World->GetSubsystem<UEquipmentInstancePoolSubsystem>() : nullptr })
+		{
+			UE_LOG(LogGAEA, Display, TEXT("EquipmentInstancePool [%s] Enabled: %s, Pooled: %d, %s"),
+				*GetNameSafe(World),
+				UEquipmentInstancePoolSubsystem::IsPoolingEnabled() ? TEXT("TRUE") : TEXT("FALSE"),
+				Subsystem->GetNumPooledInstances(),
+				*Subsystem->GetPoolStats().GetDebugString());
+		}
+	}
+
+	static FAutoConsoleCommandWithWorld CmdDumpInstancePool(
+		TEXT("GAEA.Equipment.InstancePool.Dump"),
+		TEXT("Prints the hit rate and the number of pooled EquipmentInstances in the current world."),
+		FConsoleCommandWithWorldDelegate::CreateStatic(&DumpInstancePool));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FEquipmentInstancePoolStats
+
+#pragma region FEquipmentInstancePoolStats
+
+float FEquipmentInstancePoolStats::GetHitRate() const
+{
+	const auto Total{ Hits + Misses };
+
+	return (Total > 0) ? (static_cast<float>(Hits) / static_cast<float>(Total)) : 0.0f;
+}
+
+FString FEquipmentInstancePoolStats::GetDebugString() const
+{
+	return FString::Printf(TEXT("Hits: %d, Misses: %d, HitRate: %.1f%%, Releases: %d, Discards: %d"), Hits, Misses, GetHitRate() * 100.0f, Releases, Discards);
+}
+
+#pragma endregion
+
+
+//////////////////////////////////////////////////////////////////////
+// UEquipmentInstancePoolSubsystem
+
+#pragma region UEquipmentInstancePoolSubsystem
+
+void UEquipmentInstancePoolSubsystem::Deinitialize()
+{
+	DiscardAllInstances();
+
+	Super::Deinitialize();
+}
+
+
+UEquipmentInstance* UEquipmentInstancePoolSubsystem::AcquireInstance(TSubclassOf<UEquipmentInstance> InstanceType, UObject* Outer)
+{
+	check(InstanceType);
+	check(Outer);
+
+	if (IsPoolingEnabled() && CanPoolInWorld())
+	{
+		if (auto* List{ PooledInstances.Find(InstanceType) })
+		{
+			while (!List->Instances.IsEmpty())
+			{
+				auto* Instance{ List->Instances.Pop(EAllowShrinking::No).Get() };
+
+				if (!IsValid(Instance) || !IsValid(Instance->GetOuter()))
+				{
+					continue;
+				}
+
+				// The instance has never been replicated, so it can move to another outer
+
+				if (Instance->GetOuter() != Outer)
+				{
+					Instance->Rename(nullptr, Outer, REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional | REN_ForceNoResetLoaders);
+				}
+
+				++Stats.Hits;
+
+				return Instance;
+			}
+		}
+	}
+
+	++Stats.Misses;
+
+	return NewObject<UEquipmentInstance>(Outer, InstanceType);
+}
+
+void UEquipmentInstancePoolSubsystem::ReleaseInstance(UEquipmentInstance* Instance)
+{
+	if (!IsValid(Instance))
+	{
+		return;
+	}
+
+	if (!IsPoolingEnabled() || !CanPoolInWorld())
+	{
+		++Stats.Discards;
+		return;
+	}
+
+	auto& List{ PooledInstances.FindOrAdd(Instance->GetClass()) };
+
+	if (List.Instances.Num() >= EquipmentInstancePoolCVars::MaxPooledInstancesPerType)
+	{
+		++Stats.Discards;
+		return;
+	}
+
+	Instance->ResetForReuse();
+
+	List.Instances.Add(Instance);
+
+	++Stats.Releases;
+}
+
+void UEquipmentInstancePoolSubsystem::DiscardInstancesOwnedBy(const UObject* Outer)
+{
+	for (auto& KVP : PooledInstances)
+	{
+		KVP.Value.Instances.RemoveAllSwap(
+			[Outer](const TObjectPtr<UEquipmentInstance>& Instance)
+			{
+				return !IsValid(Instance) || (Instance->GetOuter() == Outer);
+			});
+	}
+}
+
+void UEquipmentInstancePoolSubsystem::DiscardAllInstances()
+{
+	PooledInstances.Reset();
+}
+
+int32 UEquipmentInstancePoolSubsystem::GetNumPooledInstances() const
+{
+	auto Num{ 0 };
+
+	for (const auto& KVP : PooledInstances)
+	{
+		Num += KVP.Value.Instances.Num();
+	}
+
+	return Num;
+}
+
+
+bool UEquipmentInstancePoolSubsystem::CanPoolInWorld() const
+{
+	const auto* World{ GetWorld() };
+
+	return World && (World->GetNetMode() == NM_Standalone);
+}
+
+bool UEquipmentInstancePoolSubsystem::IsPoolingEnabled()
+{
+	return EquipmentInstancePoolCVars::bEnableInstancePool;
+}
+
+UEquipmentInstance* UEquipmentInstancePoolSubsystem::AcquireInstanceFor(TSubclassOf<UEquipmentInstance> InstanceType, UObject* Outer)
+{
+	check(Outer);
+
+	auto* World{ Outer->GetWorld() };
+
+	if (auto* Subsystem{ World ? World->GetSubsystem<UEquipmentInstancePoolSubsystem>() : nullptr })
+	{
+		return Subsystem->AcquireInstance(InstanceType, Outer);
+	}
+
+	return NewObject<UEquipmentInstance>(Outer, InstanceType);
+}
+
+void UEquipmentInstancePoolSubsystem::ReleaseInstanceFor(UEquipmentInstance* Instance)
+{
+	auto* World{ Instance ? Instance->GetWorld() : nullptr };
+
+	if (auto* Subsystem{ World ? World->GetSubsystem<UEquipmentInstancePoolSubsystem>() : nullptr })
+	{
+		Subsystem->ReleaseInstance(Instance);
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,149 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "EquipmentInstancePoolSubsystem.generated.h"
+
+class UEquipmentInstance;
+
+
+/**
+ * Counters to check how effective the instance pool is
+ */
+USTRUCT(BlueprintType)
+struct GAEADDON_API FEquipmentInstancePoolStats
+{
+	GENERATED_BODY()
+public:
+	FEquipmentInstancePoolStats() {}
+
+public:
+	//
+	// Number of instances reused from the pool
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 Hits{ 0 };
+
+	//
+	// Number of instances newly created because there was nothing to reuse
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 Misses{ 0 };
+
+	//
+	// Number of instances returned to the pool
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 Releases{ 0 };
+
+	//
+	// Number of instances left to GC because the pool was full or disabled
+	//
+	UPROPERTY(BlueprintReadOnly)
+	int32 Discards{ 0 };
+
+public:
+	float GetHitRate() const;
+
+	FString GetDebugString() const;
+
+};
+
+
+/**
+ * List of pooled instances of the same class
+ */
+USTRUCT()
+struct FEquipmentInstancePoolList
+{
+	GENERATED_BODY()
+public:
+	FEquipmentInstancePoolList() {}
+
+public:
+	UPROPERTY()
+	TArray<TObjectPtr<UEquipmentInstance>> Instances;
+
+};
+
+
+/**
+ * Subsystem that pools EquipmentInstances removed from EquipmentManagerComponent for each InstanceType
+ * and reuses them when the same type of Equipment is added again.
+ *
+ * Tips:
+ *	Pooling is disabled by default and can be enabled with "GAEA.Equipment.InstancePool.Enable".
+ *
+ * Note:
+ *	Instances are only pooled in a standalone world.
+ *	In a networked world, a removed instance may still be waiting for its removal to be sent to the clients,
+ *	and reusing it would resurrect the replicated subobject under the same NetGUID, so it is always left to GC.
+ */
+UCLASS()
+class GAEADDON_API UEquipmentInstancePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	UEquipmentInstancePoolSubsystem() {}
+
+	virtual void Deinitialize() override;
+
+protected:
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<UEquipmentInstance>, FEquipmentInstancePoolList> PooledInstances;
+
+	UPROPERTY(Transient)
+	FEquipmentInstancePoolStats Stats;
+
+public:
+	/**
+	 * Returns an instance of the specified type whose outer is Outer.
+	 * If there is no instance that can be reused, a new one is created.
+	 */
+	UEquipmentInstance* AcquireInstance(TSubclassOf<UEquipmentInstance> InstanceType, UObject* Outer);
+
+	/**
+	 * Resets the instance and returns it to the pool.
+	 * If pooling is disabled or the pool is full, the instance is left to GC.
+	 */
+	void ReleaseInstance(UEquipmentInstance* Instance);
+
+	/**
+	 * Discard all pooled instances whose outer is the specified object
+	 */
+	void DiscardInstancesOwnedBy(const UObject* Outer);
+
+	/**
+	 * Discard all pooled instances
+	 */
+	void DiscardAllInstances();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment")
+	FEquipmentInstancePoolStats GetPoolStats() const { return Stats; }
+
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	void ResetPoolStats() { Stats = FEquipmentInstancePoolStats(); }
+
+	int32 GetNumPooledInstances() const;
+
+	/**
+	 * Returns whether instances can be pooled in the world of this subsystem
+	 */
+	bool CanPoolInWorld() const;
+
+public:
+	static bool IsPoolingEnabled();
+
+	/**
+	 * Create or reuse an instance using the pool of the world to which Outer belongs
+	 */
+	static UEquipmentInstance* AcquireInstanceFor(TSubclassOf<UEquipmentInstance> InstanceType, UObject* Outer);
+
+	/**
+	 * Return the instance to the pool of the world to which it belongs
+	 */
+	static void ReleaseInstanceFor(UEquipmentInstance* Instance);
+
+};
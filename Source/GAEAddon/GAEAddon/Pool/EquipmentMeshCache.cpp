@@ -0,0 +1,135 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentMeshCache.h"
+
+#include "EquipmentInstance.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentMeshCache)
+
+
+USkeletalMeshComponent* FEquipmentMeshCache::AcquireMesh(const FEquipmentMeshToSpawn& SpawnInfo, const AActor* Owner)
+{
+	// Search from the most recently released
+
+	const auto* Mesh{ SpawnInfo.LoadMesh() };
+	const auto AnimClass{ SpawnInfo.LoadAnimClass() };
+
+	for (auto Index{ Entries.Num() - 1 }; Index >= 0; --Index)
+	{
+		const auto& Entry{ Entries[Index] };
+		auto* Component{ Entry.Component.Get() };
+
+		if (!IsValid(Component))
+		{
+			TotalSizeBytes -= Entry.SizeBytes;
+			Entries.RemoveAt(Index);
+			continue;
+		}
+
+		if ((Entry.Mesh == Mesh) && (Entry.AnimClass == AnimClass) && (Component->GetOwner() == Owner))
+		{
+			const auto CollisionEnabled{ Entry.CollisionEnabled };
+
+			TotalSizeBytes -= Entry.SizeBytes;
+			Entries.RemoveAt(Index);
+
+			// Start the anim instance over so that no state machine, montage or dynamics carry over from the last use
+
+			Component->InitAnim(true);
+			Component->ResetAnimInstanceDynamics(ETeleportType::ResetPhysics);
+
+			Component->SetComponentTickEnabled(true);
+			Component->SetVisibility(true);
+			Component->SetCollisionEnabled(CollisionEnabled);
+
+			return Component;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FEquipmentMeshCache::ReleaseMesh(USkeletalMeshComponent* Component, int64 BudgetBytes)
+{
+	if ((BudgetBytes <= 0) || !IsValid(Component) || !Component->IsRegistered())
+	{
+		return false;
+	}
+
+	// Only count what destroying the component would free. The mesh asset is shared with other components and stays loaded
+
+	auto SizeBytes{ Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive) };
+
+	if (auto* AnimInstance{ Component->GetAnimInstance() })
+	{
+		SizeBytes += AnimInstance->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	if (SizeBytes > BudgetBytes)
+	{
+		return false;
+	}
+
+	// Keep registered, but stop rendering, ticking and colliding
+
+	const auto CollisionEnabled{ Component->GetCollisionEnabled() };
+
+	Component->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	Component->SetVisibility(false);
+	Component->SetComponentTickEnabled(false);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	auto& NewEntry{ Entries.AddDefaulted_GetRef() };
+	NewEntry.Component = Component;
+	NewEntry.CollisionEnabled = CollisionEnabled;
+	NewEntry.Mesh = Component->GetSkeletalMeshAsset();
+	NewEntry.AnimClass = Component->GetAnimClass();
+	NewEntry.SizeBytes = SizeBytes;
+
+	TotalSizeBytes += SizeBytes;
+
+	Trim(BudgetBytes);
+
+	return true;
+}
+
+void FEquipmentMeshCache::Trim(int64 BudgetBytes)
+{
+	auto NumToRemove{ 0 };
+
+	while ((TotalSizeBytes > BudgetBytes) && Entries.IsValidIndex(NumToRemove))
+	{
+		const auto& Entry{ Entries[NumToRemove] };
+
+		if (IsValid(Entry.Component))
+		{
+			Entry.Component->DestroyComponent();
+		}
+
+		TotalSizeBytes -= Entry.SizeBytes;
+
+		++NumToRemove;
+	}
+
+	if (NumToRemove > 0)
+	{
+		Entries.RemoveAt(0, NumToRemove);
+	}
+}
+
+void FEquipmentMeshCache::Empty()
+{
+	for (const auto& Entry : Entries)
+	{
+		if (IsValid(Entry.Component))
+		{
+			Entry.Component->DestroyComponent();
+		}
+	}
+
+	Entries.Empty();
+	TotalSizeBytes = 0;
+}
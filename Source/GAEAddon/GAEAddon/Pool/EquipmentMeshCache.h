@@ -0,0 +1,101 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+
+#include "EquipmentMeshCache.generated.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+class UAnimInstance;
+class AActor;
+struct FEquipmentMeshToSpawn;
+
+
+/**
+ * Mesh component kept registered but hidden in FEquipmentMeshCache
+ */
+USTRUCT()
+struct FEquipmentMeshCacheEntry
+{
+	GENERATED_BODY()
+public:
+	FEquipmentMeshCacheEntry() {}
+
+public:
+	UPROPERTY()
+	TObjectPtr<USkeletalMeshComponent> Component{ nullptr };
+
+	UPROPERTY()
+	TObjectPtr<USkeletalMesh> Mesh{ nullptr };
+
+	UPROPERTY()
+	TSubclassOf<UAnimInstance> AnimClass{ nullptr };
+
+	//
+	// Collision of the component before it was cached, restored when it is reused
+	//
+	UPROPERTY()
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled{ ECollisionEnabled::NoCollision };
+
+	//
+	// Memory used by the component and its anim instance, not counting the shared mesh asset
+	//
+	int64 SizeBytes{ 0 };
+
+};
+
+
+/**
+ * Cache of mesh components spawned for Equipment.
+ * Instead of destroying the component when the Equipment is deactivated,
+ * it is detached and hidden, and reused when Equipment with the same mesh is activated again.
+ */
+USTRUCT()
+struct GAEADDON_API FEquipmentMeshCache
+{
+	GENERATED_BODY()
+public:
+	FEquipmentMeshCache() {}
+
+protected:
+	//
+	// Cached components in order of release (oldest first)
+	//
+	UPROPERTY()
+	TArray<FEquipmentMeshCacheEntry> Entries;
+
+	//
+	// Total memory used by the cached components and their anim instances
+	//
+	int64 TotalSizeBytes{ 0 };
+
+public:
+	/**
+	 * Returns a cached component owned by Owner that matches the spawn info, or nullptr.
+	 * The returned component is still registered and detached, and must be attached by the caller.
+	 * Its anim instance is reinitialized, so it starts in the same state as a newly spawned component.
+	 */
+	USkeletalMeshComponent* AcquireMesh(const FEquipmentMeshToSpawn& SpawnInfo, const AActor* Owner);
+
+	/**
+	 * Detaches, hides and disables collision of the component and keeps it for reuse.
+	 * Returns false if the component cannot be cached, in which case the caller should destroy it.
+	 */
+	bool ReleaseMesh(USkeletalMeshComponent* Component, int64 BudgetBytes);
+
+	/**
+	 * Destroys the oldest components until the total size fits in the budget
+	 */
+	void Trim(int64 BudgetBytes);
+
+	/**
+	 * Destroys all cached components
+	 */
+	void Empty();
+
+	int32 Num() const { return Entries.Num(); }
+	int64 GetTotalSizeBytes() const { return TotalSizeBytes; }
+
+};
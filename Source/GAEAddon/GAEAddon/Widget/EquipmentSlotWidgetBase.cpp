@@ -108,17 +108,11 @@ void UEquipmentSlotWidgetBase::ListenEquipmentSlotEvents()
 {
 	if (EquipmentManagerComponent.IsValid())
 	{
-		{
-			FScriptDelegate NewDelegate;
-			NewDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UEquipmentSlotWidgetBase, HandleSlotChanged));
-			EquipmentManagerComponent->OnEquipmentSlotChange.Add(NewDelegate);
-		}
-
-		{
-			FScriptDelegate NewDelegate;
-			NewDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UEquipmentSlotWidgetBase, HandleActiveSlotChanged));
-			EquipmentManagerComponent->OnActiveEquipmentSlotChange.Add(NewDelegate);
-		}
+		EquipmentManagerComponent->RegisterSlotListener(
+			AssociateSlotTag,
+			EEquipmentSlotMatch::ExactMatch,
+			FEquipmentSlotListenerDelegate::CreateUObject(this, &ThisClass::HandleSlotChanged),
+			FEquipmentSlotListenerDelegate::CreateUObject(this, &ThisClass::HandleActiveSlotChanged));
 	}
 }
 
@@ -126,21 +120,17 @@ void UEquipmentSlotWidgetBase::UnlistenEquipmentSlotEvents()
 {
 	if (EquipmentManagerComponent.IsValid())
 	{
-		EquipmentManagerComponent->OnEquipmentSlotChange.RemoveAll(this);
-		EquipmentManagerComponent->OnActiveEquipmentSlotChange.RemoveAll(this);
+		EquipmentManagerComponent->UnregisterSlotListeners(this);
 	}
 }
 
 
-void UEquipmentSlotWidgetBase::HandleSlotChanged(FEquipmentSlotChangedMessage Info)
+void UEquipmentSlotWidgetBase::HandleSlotChanged(const FEquipmentSlotChangedMessage& Info)
 {
-	if (Info.SlotTag == AssociateSlotTag)
-	{
-		SetEquipment(Info.Data, Info.Instance);
-	}
+	SetEquipment(Info.Data, Info.Instance);
 }
 
-void UEquipmentSlotWidgetBase::HandleActiveSlotChanged(FEquipmentSlotChangedMessage Info)
+void UEquipmentSlotWidgetBase::HandleActiveSlotChanged(const FEquipmentSlotChangedMessage& Info)
 {
 	SetIsActiveSlot(Info.SlotTag == AssociateSlotTag);
 }
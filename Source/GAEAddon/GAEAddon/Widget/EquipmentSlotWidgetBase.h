@@ -69,11 +69,8 @@ protected:
 
 
 private:
-	UFUNCTION()
-	void HandleSlotChanged(FEquipmentSlotChangedMessage Info);
-
-	UFUNCTION()
-	void HandleActiveSlotChanged(FEquipmentSlotChangedMessage Info);
+	void HandleSlotChanged(const FEquipmentSlotChangedMessage& Info);
+	void HandleActiveSlotChanged(const FEquipmentSlotChangedMessage& Info);
 
 protected:
 	virtual void SetIsActiveSlot(bool bActive);
@@ -3,3 +3,70 @@
 #include "GAEAddonLogs.h"
 
 DEFINE_LOG_CATEGORY(LogGAEA);
+DEFINE_LOG_CATEGORY(LogGAEALifecycle);
+
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+namespace GAEALifecycleLog
+{
+	static bool bEnableTrace{ false };
+	static FAutoConsoleVariableRef CVarEnableTrace(
+		TEXT("GAEA.Equipment.Lifecycle.Trace"),
+		bEnableTrace,
+		TEXT("Whether to output logs of Equipment lifecycle (equip, unequip, activate, deactivate) to LogGAEALifecycle."),
+		ECVF_Cheat);
+
+	static FString TracePawnFilter;
+	static FAutoConsoleVariableRef CVarTracePawnFilter(
+		TEXT("GAEA.Equipment.Lifecycle.TracePawn"),
+		TracePawnFilter,
+		TEXT("If set, lifecycle logs are only output for pawns whose name contains this string."),
+		ECVF_Cheat);
+
+	static const APawn* FindPawn(const UObject* Context)
+	{
+		if (const auto* Pawn{ Cast<APawn>(Context) })
+		{
+			return Pawn;
+		}
+
+		return Context ? Context->GetTypedOuter<APawn>() : nullptr;
+	}
+
+	bool ShouldTrace(const UObject* Context)
+	{
+		if (!bEnableTrace)
+		{
+			return false;
+		}
+
+		if (TracePawnFilter.IsEmpty())
+		{
+			return true;
+		}
+
+		const auto* Pawn{ FindPawn(Context) };
+
+		return Pawn && Pawn->GetName().Contains(TracePawnFilter);
+	}
+
+	FString GetContextString(const UObject* Context)
+	{
+		const auto* Pawn{ FindPawn(Context) };
+
+		if (!Pawn)
+		{
+			return TEXT("[INVALID|INVALID]");
+		}
+
+		return FString::Printf(TEXT("[%s|%s]")
+			, Pawn->HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT")
+			, Pawn->IsLocallyControlled() ? TEXT("Local") : TEXT("Other"));
+	}
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "Logging/LogMacros.h"
 
 GAEADDON_API DECLARE_LOG_CATEGORY_EXTERN(LogGAEA, Log, All);
+GAEADDON_API DECLARE_LOG_CATEGORY_EXTERN(LogGAEALifecycle, Verbose, All);
 
 #if !UE_BUILD_SHIPPING
 
@@ -28,4 +29,37 @@ GAEADDON_API DECLARE_LOG_CATEGORY_EXTERN(LogGAEA, Log, All);
 #define GAEACHECK(InExpression) InExpression
 #define GAEACHECK_MSG(InExpression, InFormat, ...) InExpression
 
-#endif
\ No newline at end of file
+#endif
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+namespace GAEALifecycleLog
+{
+	/**
+	 * Returns whether lifecycle logs should be output for the pawn to which Context belongs
+	 * 
+	 * Tips:
+	 *	Enabled with "GAEA.Equipment.Lifecycle.Trace" and filtered by "GAEA.Equipment.Lifecycle.TracePawn".
+	 */
+	GAEADDON_API bool ShouldTrace(const UObject* Context);
+
+	/**
+	 * Returns the net role of the pawn to which Context belongs as "[SERVER|Local]"
+	 */
+	GAEADDON_API FString GetContextString(const UObject* Context);
+}
+
+#define GAEALIFECYCLELOG(Context, FormattedText, ...) \
+	do \
+	{ \
+		if (GAEALifecycleLog::ShouldTrace(Context)) \
+		{ \
+			UE_LOG(LogGAEALifecycle, Verbose, FormattedText, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#else
+
+#define GAEALIFECYCLELOG(Context, FormattedText, ...) do {} while (0)
+
+#endif
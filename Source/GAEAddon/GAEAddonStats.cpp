@@ -0,0 +1,11 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "GAEAddonStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(EquipmentChannel);
+
+DEFINE_STAT(STAT_GAEA_FragmentCalls_Equiped);
+DEFINE_STAT(STAT_GAEA_FragmentCalls_Unequiped);
+DEFINE_STAT(STAT_GAEA_FragmentCalls_Activated);
+DEFINE_STAT(STAT_GAEA_FragmentCalls_Deactivated);
+DEFINE_STAT(STAT_GAEA_MeshByTagCacheMisses);
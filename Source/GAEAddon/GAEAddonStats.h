@@ -0,0 +1,31 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Equipment"), STATGROUP_Equipment, STATCAT_Advanced);
+
+UE_TRACE_CHANNEL_EXTERN(EquipmentChannel, GAEADDON_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fragment Calls (Equiped)"), STAT_GAEA_FragmentCalls_Equiped, STATGROUP_Equipment, GAEADDON_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fragment Calls (Unequiped)"), STAT_GAEA_FragmentCalls_Unequiped, STATGROUP_Equipment, GAEADDON_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fragment Calls (Activated)"), STAT_GAEA_FragmentCalls_Activated, STATGROUP_Equipment, GAEADDON_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fragment Calls (Deactivated)"), STAT_GAEA_FragmentCalls_Deactivated, STATGROUP_Equipment, GAEADDON_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Mesh By Tag Cache Misses"), STAT_GAEA_MeshByTagCacheMisses, STATGROUP_Equipment, GAEADDON_API);
+
+/**
+ * Measure the scope with a cycle stat in STATGROUP_Equipment and an Insights event in EquipmentChannel
+ */
+#define GAEA_SCOPE_CYCLE_COUNTER(Name, StatId) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(Name), StatId, STATGROUP_Equipment); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, EquipmentChannel)
+
+/**
+ * Measure the scope with an Insights event in EquipmentChannel named at runtime.
+ * The name is only built while the channel is enabled.
+ */
+#define GAEA_TRACE_SCOPE_DYNAMIC(NameExpr) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(UE_TRACE_CHANNELEXPR_IS_ENABLED(EquipmentChannel) ? *(NameExpr) : TEXT("Equipment"), EquipmentChannel)
@@ -0,0 +1,35 @@
+﻿// Copyright (C) 2024 owoDra
+
+using UnrealBuildTool;
+
+public class GAEAddonTests : ModuleRules
+{
+	public GAEAddonTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicIncludePaths.AddRange(
+            new string[]
+            {
+                ModuleDirectory,
+                ModuleDirectory + "/GAEAddonTests",
+            }
+        );
+
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "ModularGameplay",
+                "GameplayTags",
+                "GameplayAbilities",
+                "GFCore",
+                "GAExt",
+                "GAEAddon",
+            }
+        );
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright (C) 2024 owoDra
+
+#include "GAEAddonTests.h"
+
+IMPLEMENT_MODULE(FGAEAddonTestsModule, GAEAddonTests)
+
+
+void FGAEAddonTestsModule::StartupModule()
+{
+}
+
+void FGAEAddonTestsModule::ShutdownModule()
+{
+}
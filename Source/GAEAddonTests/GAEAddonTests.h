@@ -0,0 +1,16 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Modules/ModuleManager.h"
+
+/**
+ *  Modules for the automation tests of the Game Ability: Equipment Addon plugin
+ */
+class FGAEAddonTestsModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+};
@@ -0,0 +1,113 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestWorld.h"
+#include "EquipmentTestPawn.h"
+#include "EquipmentTestTags.h"
+#include "EquipmentTestAbility.h"
+
+#include "EquipmentManagerComponent.h"
+#include "EquipmentData.h"
+#include "EquipmentSet.h"
+#include "Fragment/EquipmentFragment_AddAbilities.h"
+
+#include "AbilitySystemComponent.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EquipmentActiveGrantSoakTest
+{
+	/**
+	 * Returns the number of abilities, effects and attribute sets granted to the AbilitySystemComponent
+	 */
+	static int32 GetNumGrants(const UAbilitySystemComponent* ASC)
+	{
+		return ASC->GetActivatableAbilities().Num() + ASC->GetActiveGameplayEffects().GetNumGameplayEffects() + ASC->GetSpawnedAttributes().Num();
+	}
+
+	/**
+	 * Creates EquipmentData that grants an ability only while it is activated
+	 */
+	static UEquipmentData* CreateActiveAbilityEquipmentData()
+	{
+		return FEquipmentTestWorld::CreateEquipmentData([](UEquipmentData* EquipmentData)
+			{
+				auto* Fragment{ NewObject<UEquipmentFragment_AddAbilities>(EquipmentData) };
+
+				auto& GrantedAbility{ Fragment->GrantedGameplayAbilities_OnActivated.AddDefaulted_GetRef() };
+				GrantedAbility.Ability = UEquipmentTestAbility::StaticClass();
+
+				EquipmentData->Fragments.Add(Fragment);
+			});
+	}
+}
+
+
+/**
+ * Spawns a pawn with two Equipment that grant an ability while activated, swaps the active slot repeatedly
+ * and checks that the abilities granted by the previous active Equipment are always removed.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEquipmentActiveGrantSoakTest, "GAEAddon.Soak.ActiveGrants",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FEquipmentActiveGrantSoakTest::RunTest(const FString& Parameters)
+{
+	using namespace EquipmentActiveGrantSoakTest;
+
+	const auto NumSwaps{ 10000 };
+
+	FEquipmentTestWorld TestWorld;
+
+	// Spawn a pawn with Equipment in two slots
+
+	const TArray<TPair<FGameplayTag, const UEquipmentData*>> Loadout
+	{
+		{ TAG_Equipment_Slot_Test_Primary, CreateActiveAbilityEquipmentData() },
+		{ TAG_Equipment_Slot_Test_Secondary, CreateActiveAbilityEquipmentData() },
+	};
+
+	auto* Pawn{ TestWorld.SpawnPawn(FEquipmentTestWorld::CreateEquipmentSet(Loadout, TAG_Equipment_Slot_Test_Primary)) };
+
+	if (!TestTrue(TEXT("EquipmentManagerComponent reaches GameplayReady"), Pawn != nullptr))
+	{
+		return false;
+	}
+
+	auto* EMC{ Pawn->GetEquipmentManagerComponent() };
+	const auto* ASC{ Pawn->GetAbilitySystemComponent() };
+
+	// Only the ability of the active Equipment must be granted, which also checks that OnActivated has been run
+
+	const auto ExpectedGrants{ 1 };
+
+	for (const auto& Entry : Loadout)
+	{
+		EMC->SetActiveSlot(Entry.Key);
+
+		TestEqual(FString::Printf(TEXT("Grants while [%s] is active"), *Entry.Key.ToString()), GetNumGrants(ASC), ExpectedGrants);
+	}
+
+	// Swap the active slot
+
+	auto NumUnexpectedSwaps{ 0 };
+
+	for (auto Swap{ 0 }; Swap < NumSwaps; ++Swap)
+	{
+		EMC->SetActiveSlot(Loadout[Swap % Loadout.Num()].Key);
+
+		if (GetNumGrants(ASC) != ExpectedGrants)
+		{
+			++NumUnexpectedSwaps;
+		}
+	}
+
+	TestWorld.Tick();
+
+	TestEqual(TEXT("Swaps that left a different number of grants"), NumUnexpectedSwaps, 0);
+	TestEqual(TEXT("Grants after all swaps"), GetNumGrants(ASC), ExpectedGrants);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
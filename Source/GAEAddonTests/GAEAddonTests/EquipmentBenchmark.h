@@ -0,0 +1,154 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+
+namespace EquipmentBenchmark
+{
+	/**
+	 * Counts the UObjects created while this object is alive, including objects that were destroyed again
+	 */
+	class FObjectCreateCounter : public FUObjectArray::FUObjectCreateListener
+	{
+	public:
+		FObjectCreateCounter()
+		{
+			GUObjectArray.AddUObjectCreateListener(this);
+		}
+
+		virtual ~FObjectCreateCounter() override
+		{
+			if (bListening)
+			{
+				GUObjectArray.RemoveUObjectCreateListener(this);
+			}
+		}
+
+		FObjectCreateCounter(const FObjectCreateCounter&) = delete;
+		FObjectCreateCounter& operator=(const FObjectCreateCounter&) = delete;
+
+	private:
+		int64 NumCreated{ 0 };
+		bool bListening{ true };
+
+	public:
+		virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+		{
+			++NumCreated;
+		}
+
+		virtual void OnUObjectArrayShutdown() override
+		{
+			GUObjectArray.RemoveUObjectCreateListener(this);
+			bListening = false;
+		}
+
+		int64 GetNumCreated() const { return NumCreated; }
+
+	};
+
+
+	/**
+	 * Result of one kind of operation
+	 */
+	struct FOperationResult
+	{
+	public:
+		FOperationResult(const TCHAR* InName) : Name(InName) {}
+
+	public:
+		const TCHAR* Name{ nullptr };
+
+		int32 Count{ 0 };
+		double TotalSeconds{ 0.0 };
+		int64 ObjectsCreated{ 0 };
+		int64 LiveObjectDelta{ 0 };
+		int64 AllocatedDeltaBytes{ 0 };
+
+	public:
+		static const TCHAR* GetCsvHeader()
+		{
+			return TEXT("Operation,Count,TotalMs,MsPerOp,UObjectsCreated,LiveUObjectDelta,AllocatedDeltaKB");
+		}
+
+		FString ToCsvRow() const
+		{
+			const auto TotalMs{ TotalSeconds * 1000.0 };
+			const auto MsPerOp{ (Count > 0) ? (TotalMs / Count) : 0.0 };
+
+			return FString::Printf(TEXT("%s,%d,%.4f,%.6f,%lld,%lld,%lld"), Name, Count, TotalMs, MsPerOp, ObjectsCreated, LiveObjectDelta, AllocatedDeltaBytes / 1024);
+		}
+	};
+
+
+	/**
+	 * Returns the memory currently allocated through the tracked allocators, or INDEX_NONE if LLM is not enabled (-LLM)
+	 */
+	inline int64 GetAllocatedBytes()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			auto& Tracker{ FLowLevelMemTracker::Get() };
+			Tracker.UpdateStatsPerFrame();
+
+			return Tracker.GetTagAmountForTracker(ELLMTracker::Default, ELLMTag::Total);
+		}
+#endif // ENABLE_LOW_LEVEL_MEM_TRACKER
+
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Measure time, created UObjects, the net change of live UObjects and allocated memory while running the function
+	 * 
+	 * Note:
+	 *	UObjectsCreated counts every object constructed during the function.
+	 *	LiveUObjectDelta is the net change of the object array, so objects created and destroyed again cancel out.
+	 */
+	template<typename FuncType>
+	void Measure(FOperationResult& Result, int32 NumOps, FuncType&& Func)
+	{
+		FObjectCreateCounter CreateCounter;
+
+		const auto ObjectsBefore{ GUObjectArray.GetObjectArrayNumMinusAvailable() };
+		const auto AllocatedBefore{ GetAllocatedBytes() };
+		const auto StartTime{ FPlatformTime::Seconds() };
+
+		Func();
+
+		Result.TotalSeconds += FPlatformTime::Seconds() - StartTime;
+		Result.Count += NumOps;
+		Result.ObjectsCreated += CreateCounter.GetNumCreated();
+		Result.LiveObjectDelta += GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+
+		if (AllocatedBefore != INDEX_NONE)
+		{
+			Result.AllocatedDeltaBytes += GetAllocatedBytes() - AllocatedBefore;
+		}
+	}
+
+	/**
+	 * Writes the results as CSV to the Equipment profiling directory and returns the written path, or empty if it failed
+	 */
+	inline FString WriteCsv(const FString& BaseName, const FString& Description, const TArray<const FOperationResult*>& Results)
+	{
+		TArray<FString> Lines;
+		Lines.Add(FString::Printf(TEXT("# %s, LLM: %s"), *Description, (GetAllocatedBytes() != INDEX_NONE) ? TEXT("Enabled") : TEXT("Disabled")));
+		Lines.Add(FOperationResult::GetCsvHeader());
+
+		for (const auto* Result : Results)
+		{
+			Lines.Add(Result->ToCsvRow());
+		}
+
+		const auto OutputPath{ FPaths::Combine(FPaths::ProfilingDir(), TEXT("Equipment"), FString::Printf(TEXT("%s-%s.csv"), *BaseName, *FDateTime::Now().ToString())) };
+
+		return FFileHelper::SaveStringArrayToFile(Lines, *OutputPath) ? OutputPath : FString();
+	}
+}
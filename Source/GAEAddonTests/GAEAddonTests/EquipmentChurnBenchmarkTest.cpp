@@ -0,0 +1,143 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestWorld.h"
+#include "EquipmentTestPawn.h"
+#include "EquipmentTestTags.h"
+#include "EquipmentBenchmark.h"
+
+#include "EquipmentManagerComponent.h"
+#include "EquipmentSet.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Spawns pawns with three Equipment in a listen server test world and measures removing, adding, activating and resetting them repeatedly.
+ * The cost per operation is written as CSV to the profiling directory.
+ * 
+ * Tips:
+ *	Run with -LLM to also measure the allocated memory.
+ * 
+ * Note:
+ *	No client is connected, so subobject registration and net conditions are measured but sending to connections is not.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FEquipmentChurnBenchmarkTest, "GAEAddon.Benchmark.Churn",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+void FEquipmentChurnBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const auto NumPawns : { 1, 16, 64 })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%d Pawns"), NumPawns));
+		OutTestCommands.Add(FString::FromInt(NumPawns));
+	}
+}
+
+bool FEquipmentChurnBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace EquipmentBenchmark;
+
+	const auto NumPawns{ FMath::Max(1, FCString::Atoi(*Parameters)) };
+	const auto Iterations{ 100 };
+
+	FEquipmentTestWorld TestWorld{ NM_ListenServer };
+
+	if (!TestEqual(TEXT("Test world net mode"), TestWorld.GetWorld()->GetNetMode(), NM_ListenServer))
+	{
+		return false;
+	}
+
+	// Spawn pawns with Equipment in three slots
+
+	const TArray<TPair<FGameplayTag, const UEquipmentData*>> Loadout
+	{
+		{ TAG_Equipment_Slot_Test_Primary, FEquipmentTestWorld::CreateEquipmentData() },
+		{ TAG_Equipment_Slot_Test_Secondary, FEquipmentTestWorld::CreateEquipmentData() },
+		{ TAG_Equipment_Slot_Test_Tertiary, FEquipmentTestWorld::CreateEquipmentData() },
+	};
+
+	const auto* EquipmentSet{ FEquipmentTestWorld::CreateEquipmentSet(Loadout, TAG_Equipment_Slot_Test_Primary) };
+
+	TArray<FEquipmentSetEntry> Entries{ EquipmentSet->Entries };
+
+	TArray<UEquipmentManagerComponent*> Components;
+
+	for (auto Index{ 0 }; Index < NumPawns; ++Index)
+	{
+		auto* Pawn{ TestWorld.SpawnPawn(EquipmentSet) };
+
+		if (!TestTrue(TEXT("EquipmentManagerComponent reaches GameplayReady"), Pawn != nullptr))
+		{
+			return false;
+		}
+
+		Components.Add(Pawn->GetEquipmentManagerComponent());
+	}
+
+	// Run churn
+
+	FOperationResult AddRemove{ TEXT("RemoveAndAddEquipment") };
+	FOperationResult SetActive{ TEXT("SetActiveSlot") };
+	FOperationResult Reset{ TEXT("ResetEquipments") };
+
+	for (auto Iteration{ 0 }; Iteration < Iterations; ++Iteration)
+	{
+		for (auto* EMC : Components)
+		{
+			Measure(AddRemove, Entries.Num(), [EMC, &Entries]()
+				{
+					for (const auto& Entry : Entries)
+					{
+						EMC->RemoveEquipment(Entry.SlotTag);
+						EMC->AddEquipment(Entry.SlotTag, Entry.EquipmentData, false);
+					}
+				});
+
+			Measure(SetActive, Entries.Num(), [EMC, &Entries]()
+				{
+					for (const auto& Entry : Entries)
+					{
+						EMC->SetActiveSlot(Entry.SlotTag);
+					}
+				});
+
+			Measure(Reset, 1, [EMC, &Entries, EquipmentSet]()
+				{
+					EMC->ResetEquipments(Entries, EquipmentSet->DefaultActiveSlotTag);
+				});
+		}
+
+		TestWorld.Tick();
+	}
+
+	// Every component must end with the loadout applied
+
+	for (const auto* EMC : Components)
+	{
+		for (const auto& Entry : Entries)
+		{
+			const auto* ContainerEntry{ EMC->GetEquipmentContainer().FindEntry(Entry.SlotTag) };
+
+			TestTrue(FString::Printf(TEXT("Slot [%s] has its Equipment after churn"), *Entry.SlotTag.ToString()), ContainerEntry && (ContainerEntry->Data == Entry.EquipmentData));
+		}
+	}
+
+	// Output CSV
+
+	const auto OutputPath{ WriteCsv(FString::Printf(TEXT("EquipmentChurn-%dPawns"), NumPawns), FString::Printf(TEXT("Pawns: %d, Iterations: %d"), NumPawns, Iterations), { &AddRemove, &SetActive, &Reset }) };
+
+	if (!OutputPath.IsEmpty())
+	{
+		AddInfo(FString::Printf(TEXT("Results written to %s"), *OutputPath));
+	}
+
+	for (const auto* Result : { &AddRemove, &SetActive, &Reset })
+	{
+		AddInfo(Result->ToCsvRow());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
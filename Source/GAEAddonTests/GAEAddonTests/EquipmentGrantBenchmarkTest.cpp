@@ -0,0 +1,225 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestWorld.h"
+#include "EquipmentTestPawn.h"
+#include "EquipmentTestTags.h"
+#include "EquipmentTestAbility.h"
+#include "EquipmentTestEffect.h"
+#include "EquipmentTestAttributeSet.h"
+#include "EquipmentBenchmark.h"
+
+#include "EquipmentManagerComponent.h"
+#include "EquipmentData.h"
+#include "Fragment/EquipmentFragment_AddAbilities.h"
+
+#include "AbilitySystemComponent.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EquipmentGrantBenchmarkTest
+{
+	static const int32 NumAbilitiesOnEquiped{ 8 };
+	static const int32 NumEffectsOnEquiped{ 2 };
+	static const int32 NumAttributeSetsOnEquiped{ 1 };
+	static const int32 NumAbilitiesOnActivated{ 4 };
+	static const int32 NumEffectsOnActivated{ 1 };
+
+	static const int32 ExpectedGrants{ NumAbilitiesOnEquiped + NumEffectsOnEquiped + NumAttributeSetsOnEquiped + NumAbilitiesOnActivated + NumEffectsOnActivated };
+
+	/**
+	 * Returns the number of abilities, effects and attribute sets granted to the AbilitySystemComponent
+	 */
+	static int32 GetNumGrants(const UAbilitySystemComponent* ASC)
+	{
+		return ASC->GetActivatableAbilities().Num() + ASC->GetActiveGameplayEffects().GetNumGameplayEffects() + ASC->GetSpawnedAttributes().Num();
+	}
+
+	/**
+	 * Creates EquipmentData that grants abilities, effects and an attribute set when equiped and activated
+	 */
+	static UEquipmentData* CreateGrantEquipmentData()
+	{
+		return FEquipmentTestWorld::CreateEquipmentData([](UEquipmentData* EquipmentData)
+			{
+				auto* Fragment{ NewObject<UEquipmentFragment_AddAbilities>(EquipmentData) };
+
+				for (auto Index{ 0 }; Index < NumAbilitiesOnEquiped; ++Index)
+				{
+					Fragment->GrantedGameplayAbilities_OnEquiped.AddDefaulted_GetRef().Ability = UEquipmentTestAbility::StaticClass();
+				}
+
+				for (auto Index{ 0 }; Index < NumEffectsOnEquiped; ++Index)
+				{
+					Fragment->GrantedGameplayEffects_OnEquiped.AddDefaulted_GetRef().GameplayEffect = UEquipmentTestEffect::StaticClass();
+				}
+
+				for (auto Index{ 0 }; Index < NumAttributeSetsOnEquiped; ++Index)
+				{
+					Fragment->GrantedAttributes_OnEquiped.AddDefaulted_GetRef().AttributeSet = UEquipmentTestAttributeSet::StaticClass();
+				}
+
+				for (auto Index{ 0 }; Index < NumAbilitiesOnActivated; ++Index)
+				{
+					Fragment->GrantedGameplayAbilities_OnActivated.AddDefaulted_GetRef().Ability = UEquipmentTestAbility::StaticClass();
+				}
+
+				for (auto Index{ 0 }; Index < NumEffectsOnActivated; ++Index)
+				{
+					Fragment->GrantedGameplayEffects_OnActivated.AddDefaulted_GetRef().GameplayEffect = UEquipmentTestEffect::StaticClass();
+				}
+
+				EquipmentData->Fragments.Add(Fragment);
+			});
+	}
+}
+
+
+/**
+ * Spawns pawns in a test world and measures equiping and unequiping Equipment that grants abilities, effects and an attribute set,
+ * once with the grants built through FAbilitySet_GrantedHandles for each pawn and once cloned from the fragment's grant template.
+ * The cost per operation is written as CSV to the profiling directory.
+ * 
+ * Tips:
+ *	Run with -LLM to also measure the allocated memory.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FEquipmentGrantBenchmarkTest, "GAEAddon.Benchmark.Grant",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+void FEquipmentGrantBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const auto NumPawns : { 1, 16, 64 })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%d Pawns"), NumPawns));
+		OutTestCommands.Add(FString::FromInt(NumPawns));
+	}
+}
+
+bool FEquipmentGrantBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace EquipmentBenchmark;
+	using namespace EquipmentGrantBenchmarkTest;
+
+	const auto NumPawns{ FMath::Max(1, FCString::Atoi(*Parameters)) };
+	const auto Iterations{ 100 };
+
+	auto* CVarEnableTemplate{ IConsoleManager::Get().FindConsoleVariable(TEXT("GAEA.Equipment.GrantTemplate.Enable")) };
+
+	if (!TestNotNull(TEXT("GAEA.Equipment.GrantTemplate.Enable"), CVarEnableTemplate))
+	{
+		return false;
+	}
+
+	const auto bWasTemplateEnabled{ CVarEnableTemplate->GetBool() };
+
+	FOperationResult EquipBuilt{ TEXT("Equip (Built)") };
+	FOperationResult UnequipBuilt{ TEXT("Unequip (Built)") };
+	FOperationResult EquipTemplate{ TEXT("Equip (Template)") };
+	FOperationResult UnequipTemplate{ TEXT("Unequip (Template)") };
+
+	for (const auto bUseTemplate : { false, true })
+	{
+		CVarEnableTemplate->Set(bUseTemplate, ECVF_SetByCode);
+
+		auto& Equip{ bUseTemplate ? EquipTemplate : EquipBuilt };
+		auto& Unequip{ bUseTemplate ? UnequipTemplate : UnequipBuilt };
+
+		FEquipmentTestWorld TestWorld;
+
+		// New EquipmentData for each path, so that the template is recorded from scratch
+
+		const auto* EquipmentData{ CreateGrantEquipmentData() };
+		const auto* EquipmentSet{ FEquipmentTestWorld::CreateEquipmentSet({}) };
+
+		TArray<UEquipmentManagerComponent*> Components;
+
+		for (auto Index{ 0 }; Index < NumPawns; ++Index)
+		{
+			auto* Pawn{ TestWorld.SpawnPawn(EquipmentSet) };
+
+			if (!TestTrue(TEXT("EquipmentManagerComponent reaches GameplayReady"), Pawn != nullptr))
+			{
+				CVarEnableTemplate->Set(bWasTemplateEnabled, ECVF_SetByCode);
+				return false;
+			}
+
+			Components.Add(Pawn->GetEquipmentManagerComponent());
+		}
+
+		// Equip once before measuring, which records the template
+
+		Components[0]->AddEquipment(TAG_Equipment_Slot_Test_Primary, EquipmentData);
+		Components[0]->RemoveEquipment(TAG_Equipment_Slot_Test_Primary);
+
+		// Run equip and unequip
+
+		auto NumUnexpectedEquips{ 0 };
+		auto NumUnexpectedUnequips{ 0 };
+
+		for (auto Iteration{ 0 }; Iteration < Iterations; ++Iteration)
+		{
+			Measure(Equip, Components.Num(), [&Components, EquipmentData]()
+				{
+					for (auto* EMC : Components)
+					{
+						EMC->AddEquipment(TAG_Equipment_Slot_Test_Primary, EquipmentData);
+					}
+				});
+
+			for (const auto* EMC : Components)
+			{
+				if (GetNumGrants(EMC->GetAbilitySystemComponent()) != ExpectedGrants)
+				{
+					++NumUnexpectedEquips;
+				}
+			}
+
+			Measure(Unequip, Components.Num(), [&Components]()
+				{
+					for (auto* EMC : Components)
+					{
+						EMC->RemoveEquipment(TAG_Equipment_Slot_Test_Primary);
+					}
+				});
+
+			for (const auto* EMC : Components)
+			{
+				if (GetNumGrants(EMC->GetAbilitySystemComponent()) != 0)
+				{
+					++NumUnexpectedUnequips;
+				}
+			}
+
+			TestWorld.Tick();
+		}
+
+		// Both paths must grant and remove the same abilities, effects and attribute sets
+
+		const auto* PathName{ bUseTemplate ? TEXT("Template") : TEXT("Built") };
+
+		TestEqual(FString::Printf(TEXT("Equips that granted a different number of grants (%s)"), PathName), NumUnexpectedEquips, 0);
+		TestEqual(FString::Printf(TEXT("Unequips that left grants (%s)"), PathName), NumUnexpectedUnequips, 0);
+	}
+
+	CVarEnableTemplate->Set(bWasTemplateEnabled, ECVF_SetByCode);
+
+	// Output CSV
+
+	const auto OutputPath{ WriteCsv(FString::Printf(TEXT("EquipmentGrant-%dPawns"), NumPawns), FString::Printf(TEXT("Pawns: %d, Iterations: %d, Grants: %d"), NumPawns, Iterations, ExpectedGrants), { &EquipBuilt, &EquipTemplate, &UnequipBuilt, &UnequipTemplate }) };
+
+	if (!OutputPath.IsEmpty())
+	{
+		AddInfo(FString::Printf(TEXT("Results written to %s"), *OutputPath));
+	}
+
+	for (const auto* Result : { &EquipBuilt, &EquipTemplate, &UnequipBuilt, &UnequipTemplate })
+	{
+		AddInfo(Result->ToCsvRow());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,111 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestWorld.h"
+#include "EquipmentTestPawn.h"
+#include "EquipmentTestTags.h"
+
+#include "EquipmentManagerComponent.h"
+#include "EquipmentInstance.h"
+#include "Pool/EquipmentInstancePoolSubsystem.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Removes and adds Equipment with the instance pool enabled and checks that instances are only reused in a standalone world
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEquipmentInstancePoolNetModeTest, "GAEAddon.Pool.NetMode",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FEquipmentInstancePoolNetModeTest::RunTest(const FString& Parameters)
+{
+	auto* CVarEnablePool{ IConsoleManager::Get().FindConsoleVariable(TEXT("GAEA.Equipment.InstancePool.Enable")) };
+
+	if (!TestNotNull(TEXT("GAEA.Equipment.InstancePool.Enable"), CVarEnablePool))
+	{
+		return false;
+	}
+
+	const auto bWasPoolEnabled{ CVarEnablePool->GetBool() };
+
+	CVarEnablePool->Set(true, ECVF_SetByCode);
+
+	for (const auto NetMode : { NM_Standalone, NM_ListenServer })
+	{
+		const auto bStandalone{ NetMode == NM_Standalone };
+		const auto* Context{ bStandalone ? TEXT("Standalone") : TEXT("ListenServer") };
+
+		FEquipmentTestWorld TestWorld{ NetMode };
+
+		if (!TestEqual(FString::Printf(TEXT("%s: Test world net mode"), Context), TestWorld.GetWorld()->GetNetMode(), NetMode))
+		{
+			continue;
+		}
+
+		// Spawn a pawn with Equipment in the primary slot
+
+		const auto* Data{ FEquipmentTestWorld::CreateEquipmentData() };
+
+		const TArray<TPair<FGameplayTag, const UEquipmentData*>> Loadout
+		{
+			{ TAG_Equipment_Slot_Test_Primary, Data },
+		};
+
+		auto* Pawn{ TestWorld.SpawnPawn(FEquipmentTestWorld::CreateEquipmentSet(Loadout, TAG_Equipment_Slot_Test_Primary)) };
+
+		if (!TestTrue(FString::Printf(TEXT("%s: EquipmentManagerComponent reaches GameplayReady"), Context), Pawn != nullptr))
+		{
+			continue;
+		}
+
+		auto* EMC{ Pawn->GetEquipmentManagerComponent() };
+		auto* PoolSubsystem{ TestWorld.GetWorld()->GetSubsystem<UEquipmentInstancePoolSubsystem>() };
+
+		if (!TestNotNull(FString::Printf(TEXT("%s: EquipmentInstancePoolSubsystem"), Context), PoolSubsystem))
+		{
+			continue;
+		}
+
+		const auto* Entry{ EMC->GetEquipmentContainer().FindEntry(TAG_Equipment_Slot_Test_Primary) };
+		const UEquipmentInstance* PrevInstance{ Entry ? Entry->Instance : nullptr };
+
+		TestNotNull(FString::Printf(TEXT("%s: Instance of the initial Equipment"), Context), PrevInstance);
+
+		// Remove and add the same Equipment again
+
+		PoolSubsystem->ResetPoolStats();
+
+		EMC->RemoveEquipment(TAG_Equipment_Slot_Test_Primary);
+		TestWorld.Tick();
+
+		EMC->AddEquipment(TAG_Equipment_Slot_Test_Primary, Data, false);
+		TestWorld.Tick();
+
+		Entry = EMC->GetEquipmentContainer().FindEntry(TAG_Equipment_Slot_Test_Primary);
+		const UEquipmentInstance* NewInstance{ Entry ? Entry->Instance : nullptr };
+
+		TestNotNull(FString::Printf(TEXT("%s: Instance of the added Equipment"), Context), NewInstance);
+
+		const auto Stats{ PoolSubsystem->GetPoolStats() };
+
+		if (bStandalone)
+		{
+			TestTrue(FString::Printf(TEXT("%s: Removed instance is reused"), Context), NewInstance == PrevInstance);
+			TestEqual(FString::Printf(TEXT("%s: Pool hits"), Context), Stats.Hits, 1);
+		}
+		else
+		{
+			TestFalse(FString::Printf(TEXT("%s: Removed instance is reused"), Context), NewInstance == PrevInstance);
+			TestEqual(FString::Printf(TEXT("%s: Pool hits"), Context), Stats.Hits, 0);
+			TestEqual(FString::Printf(TEXT("%s: Pooled instances"), Context), PoolSubsystem->GetNumPooledInstances(), 0);
+		}
+	}
+
+	CVarEnablePool->Set(bWasPoolEnabled, ECVF_SetByCode);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
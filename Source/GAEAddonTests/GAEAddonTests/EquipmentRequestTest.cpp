@@ -0,0 +1,88 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestWorld.h"
+#include "EquipmentTestPawn.h"
+#include "EquipmentTestTags.h"
+
+#include "EquipmentManagerComponent.h"
+#include "EquipmentRequest.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EquipmentRequestTest
+{
+	/**
+	 * Runs ServerRequestEquipmentChanges on the server as if the RPC had been received from the owning client
+	 */
+	static void ReceiveClientRequests(UEquipmentManagerComponent* EMC, const TArray<FEquipmentSlotRequest>& Requests)
+	{
+		struct FServerRequestEquipmentChangesParams
+		{
+			TArray<FEquipmentSlotRequest> Requests;
+		};
+
+		FServerRequestEquipmentChangesParams Params{ Requests };
+
+		EMC->ProcessEvent(EMC->FindFunctionChecked(TEXT("ServerRequestEquipmentChanges")), &Params);
+	}
+}
+
+
+/**
+ * Sends slot requests to the server as the owning client and checks that adding Equipment that was not approved is refused
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEquipmentForgedAddRequestTest, "GAEAddon.Request.ForgedAdd",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FEquipmentForgedAddRequestTest::RunTest(const FString& Parameters)
+{
+	using namespace EquipmentRequestTest;
+
+	FEquipmentTestWorld TestWorld;
+
+	// Spawn a pawn with Equipment in the primary slot
+
+	const auto* PrimaryData{ FEquipmentTestWorld::CreateEquipmentData() };
+
+	const TArray<TPair<FGameplayTag, const UEquipmentData*>> Loadout
+	{
+		{ TAG_Equipment_Slot_Test_Primary, PrimaryData },
+	};
+
+	auto* Pawn{ TestWorld.SpawnPawn(FEquipmentTestWorld::CreateEquipmentSet(Loadout, TAG_Equipment_Slot_Test_Primary)) };
+
+	if (!TestTrue(TEXT("EquipmentManagerComponent reaches GameplayReady"), Pawn != nullptr))
+	{
+		return false;
+	}
+
+	auto* EMC{ Pawn->GetEquipmentManagerComponent() };
+
+	// Equipment that is not in ClientAddableEquipments must not be added, either to an empty or an occupied slot
+
+	const auto* ForgedData{ FEquipmentTestWorld::CreateEquipmentData() };
+
+	const FEquipmentSlotRequest ForgedAddToEmpty{ EEquipmentRequestType::Add, TAG_Equipment_Slot_Test_Secondary, ForgedData };
+	const FEquipmentSlotRequest ForgedAddToOccupied{ EEquipmentRequestType::Add, TAG_Equipment_Slot_Test_Primary, ForgedData };
+
+	TestFalse(TEXT("Forged Add is accepted"), EMC->CanAcceptEquipmentRequest(ForgedAddToEmpty));
+
+	ReceiveClientRequests(EMC, { ForgedAddToEmpty, ForgedAddToOccupied });
+
+	TestNull(TEXT("Entry added to the empty slot by the forged request"), EMC->GetEquipmentContainer().FindEntry(TAG_Equipment_Slot_Test_Secondary));
+
+	const auto* PrimaryEntry{ EMC->GetEquipmentContainer().FindEntry(TAG_Equipment_Slot_Test_Primary) };
+	TestTrue(TEXT("Occupied slot keeps its Equipment after the forged request"), PrimaryEntry && (PrimaryEntry->Data == PrimaryData));
+
+	// Requests that do not add Equipment are still accepted from the client
+
+	ReceiveClientRequests(EMC, { FEquipmentSlotRequest{ EEquipmentRequestType::Remove, TAG_Equipment_Slot_Test_Primary } });
+
+	TestNull(TEXT("Entry left in the slot removed by the client request"), EMC->GetEquipmentContainer().FindEntry(TAG_Equipment_Slot_Test_Primary));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
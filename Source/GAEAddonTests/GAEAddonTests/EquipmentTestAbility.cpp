@@ -0,0 +1,11 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestAbility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentTestAbility)
+
+
+UEquipmentTestAbility::UEquipmentTestAbility(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
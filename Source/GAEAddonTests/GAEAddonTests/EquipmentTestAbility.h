@@ -0,0 +1,20 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Ability/GameplayAbility_Equipment.h"
+
+#include "EquipmentTestAbility.generated.h"
+
+
+/**
+ * Equipment ability without any behavior, used by automation tests to count granted abilities
+ */
+UCLASS(NotBlueprintable, Transient)
+class UEquipmentTestAbility : public UGameplayAbility_Equipment
+{
+	GENERATED_BODY()
+public:
+	UEquipmentTestAbility(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+};
@@ -0,0 +1,10 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestAttributeSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentTestAttributeSet)
+
+
+UEquipmentTestAttributeSet::UEquipmentTestAttributeSet()
+{
+}
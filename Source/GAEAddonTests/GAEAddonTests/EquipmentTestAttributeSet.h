@@ -0,0 +1,20 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "AttributeSet.h"
+
+#include "EquipmentTestAttributeSet.generated.h"
+
+
+/**
+ * Attribute set without any attributes, used by automation tests to count granted attribute sets
+ */
+UCLASS(NotBlueprintable, Transient)
+class UEquipmentTestAttributeSet : public UAttributeSet
+{
+	GENERATED_BODY()
+public:
+	UEquipmentTestAttributeSet();
+
+};
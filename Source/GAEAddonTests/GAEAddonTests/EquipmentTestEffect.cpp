@@ -0,0 +1,12 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestEffect.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentTestEffect)
+
+
+UEquipmentTestEffect::UEquipmentTestEffect(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DurationPolicy = EGameplayEffectDurationType::Infinite;
+}
@@ -0,0 +1,20 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayEffect.h"
+
+#include "EquipmentTestEffect.generated.h"
+
+
+/**
+ * Infinite effect without any modifiers, used by automation tests to count applied effects
+ */
+UCLASS(NotBlueprintable, Transient)
+class UEquipmentTestEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+public:
+	UEquipmentTestEffect(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+};
@@ -0,0 +1,50 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestPawn.h"
+
+#include "EquipmentManagerComponent.h"
+
+#include "InitState/InitStateTags.h"
+
+#include "GAEAbilitySystemComponent.h"
+
+#include "Components/GameFrameworkComponentManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EquipmentTestPawn)
+
+
+AEquipmentTestPawn::AEquipmentTestPawn(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	AbilitySystemComponent = CreateDefaultSubobject<UGAEAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	EquipmentManagerComponent = CreateDefaultSubobject<UEquipmentManagerComponent>(TEXT("EquipmentManagerComponent"));
+}
+
+
+UAbilitySystemComponent* AEquipmentTestPawn::GetAbilitySystemComponent() const
+{
+	return AbilitySystemComponent;
+}
+
+
+void AEquipmentTestPawn::InitializeEquipment(const UEquipmentSet* EquipmentSet)
+{
+	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+
+	if (auto* Manager{ UGameFrameworkComponentManager::GetForActor(this) })
+	{
+		if (!Manager->HasFeatureReachedInitState(this, UGAEAbilitySystemComponent::NAME_ActorFeatureName, TAG_InitState_DataInitialized))
+		{
+			Manager->ChangeFeatureInitState(this, UGAEAbilitySystemComponent::NAME_ActorFeatureName, AbilitySystemComponent, TAG_InitState_DataInitialized);
+		}
+	}
+
+	EquipmentManagerComponent->SetInitialEquipmentSet(EquipmentSet);
+}
+
+bool AEquipmentTestPawn::IsEquipmentReady() const
+{
+	return EquipmentManagerComponent->HasReachedInitState(TAG_InitState_GameplayReady);
+}
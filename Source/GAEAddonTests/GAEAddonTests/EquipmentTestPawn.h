@@ -0,0 +1,54 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameFramework/Pawn.h"
+#include "AbilitySystemInterface.h"
+
+#include "EquipmentTestPawn.generated.h"
+
+class UGAEAbilitySystemComponent;
+class UEquipmentManagerComponent;
+class UEquipmentSet;
+
+
+/**
+ * Minimal pawn with an AbilitySystemComponent and an EquipmentManagerComponent used by automation tests
+ */
+UCLASS(NotBlueprintable, Transient)
+class AEquipmentTestPawn
+	: public APawn
+	, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+public:
+	AEquipmentTestPawn(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	UPROPERTY()
+	TObjectPtr<UGAEAbilitySystemComponent> AbilitySystemComponent;
+
+	UPROPERTY()
+	TObjectPtr<UEquipmentManagerComponent> EquipmentManagerComponent;
+
+public:
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
+
+	UEquipmentManagerComponent* GetEquipmentManagerComponent() const { return EquipmentManagerComponent; }
+
+public:
+	/**
+	 * Initializes the ability system and starts the initialization of EquipmentManagerComponent with the EquipmentSet
+	 * 
+	 * Note:
+	 *	The pawn has no Controller or PlayerState that would normally drive the initialization of the AbilitySystemComponent,
+	 *	so its init state is advanced to DataInitialized here.
+	 */
+	void InitializeEquipment(const UEquipmentSet* EquipmentSet);
+
+	/**
+	 * Returns whether EquipmentManagerComponent has reached GameplayReady
+	 */
+	bool IsEquipmentReady() const;
+
+};
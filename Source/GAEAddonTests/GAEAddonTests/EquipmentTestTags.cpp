@@ -0,0 +1,11 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestTags.h"
+
+
+////////////////////////////////////
+// Equipment.Slot.Test
+
+UE_DEFINE_GAMEPLAY_TAG(TAG_Equipment_Slot_Test_Primary		, "Equipment.Slot.Test.Primary");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Equipment_Slot_Test_Secondary	, "Equipment.Slot.Test.Secondary");
+UE_DEFINE_GAMEPLAY_TAG(TAG_Equipment_Slot_Test_Tertiary		, "Equipment.Slot.Test.Tertiary");
@@ -0,0 +1,13 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "NativeGameplayTags.h"
+
+
+////////////////////////////////////
+// Equipment.Slot.Test
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Equipment_Slot_Test_Primary);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Equipment_Slot_Test_Secondary);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Equipment_Slot_Test_Tertiary);
@@ -0,0 +1,115 @@
+﻿// Copyright (C) 2024 owoDra
+
+#include "EquipmentTestWorld.h"
+
+#include "EquipmentTestPawn.h"
+
+#include "EquipmentData.h"
+#include "EquipmentSet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "UObject/Package.h"
+
+
+FEquipmentTestWorld::FEquipmentTestWorld(ENetMode InNetMode)
+{
+	check((InNetMode == NM_Standalone) || (InNetMode == NM_ListenServer));
+
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("EquipmentTestWorld"));
+	check(World);
+
+	auto& WorldContext{ GEngine->CreateNewWorldContext(EWorldType::Game) };
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+
+	// Listen with the game net driver before the actors are initialized, as when a map is loaded with ?listen.
+	// If listening fails the world stays in NM_Standalone, which tests check with GetNetMode().
+
+	if (InNetMode == NM_ListenServer)
+	{
+		URL.AddOption(TEXT("Listen"));
+
+		World->Listen(URL);
+	}
+
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+}
+
+FEquipmentTestWorld::~FEquipmentTestWorld()
+{
+	if (World)
+	{
+		GEngine->ShutdownWorldNetDriver(World);
+		GEngine->DestroyWorldContext(World);
+
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+		World = nullptr;
+	}
+}
+
+
+void FEquipmentTestWorld::Tick(int32 NumFrames, float DeltaSeconds)
+{
+	for (auto Frame{ 0 }; Frame < NumFrames; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+}
+
+AEquipmentTestPawn* FEquipmentTestWorld::SpawnPawn(const UEquipmentSet* EquipmentSet, int32 MaxFrames)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	auto* Pawn{ World->SpawnActor<AEquipmentTestPawn>(SpawnParams) };
+	if (!Pawn)
+	{
+		return nullptr;
+	}
+
+	Pawn->InitializeEquipment(EquipmentSet);
+
+	// The initial equipment set may be applied over several frames by the grant queue
+
+	for (auto Frame{ 0 }; !Pawn->IsEquipmentReady() && (Frame < MaxFrames); ++Frame)
+	{
+		Tick();
+	}
+
+	return Pawn->IsEquipmentReady() ? Pawn : nullptr;
+}
+
+
+UEquipmentData* FEquipmentTestWorld::CreateEquipmentData(TFunctionRef<void(UEquipmentData*)> AddFragments)
+{
+	auto* EquipmentData{ NewObject<UEquipmentData>(GetTransientPackage(), NAME_None, RF_Transient) };
+	EquipmentData->DisplayName = FText::FromString(TEXT("Test Equipment"));
+
+	AddFragments(EquipmentData);
+
+	return EquipmentData;
+}
+
+UEquipmentData* FEquipmentTestWorld::CreateEquipmentData()
+{
+	return CreateEquipmentData([](UEquipmentData*) {});
+}
+
+UEquipmentSet* FEquipmentTestWorld::CreateEquipmentSet(const TArray<TPair<FGameplayTag, const UEquipmentData*>>& Entries, FGameplayTag DefaultActiveSlotTag)
+{
+	auto* EquipmentSet{ NewObject<UEquipmentSet>(GetTransientPackage(), NAME_None, RF_Transient) };
+	EquipmentSet->DefaultActiveSlotTag = DefaultActiveSlotTag;
+
+	for (const auto& Entry : Entries)
+	{
+		auto& NewEntry{ EquipmentSet->Entries.AddDefaulted_GetRef() };
+		NewEntry.SlotTag = Entry.Key;
+		NewEntry.EquipmentData = Entry.Value;
+	}
+
+	return EquipmentSet;
+}
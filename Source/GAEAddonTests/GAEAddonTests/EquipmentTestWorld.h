@@ -0,0 +1,62 @@
+﻿// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+#include "Engine/EngineBaseTypes.h"
+
+class UWorld;
+class UEquipmentData;
+class UEquipmentFragmentBase;
+class UEquipmentSet;
+class AEquipmentTestPawn;
+
+
+/**
+ * Game world created for an automation test and destroyed with this object
+ * 
+ * Tips:
+ *	By default the world runs without a net driver (NM_Standalone) and has authority over all actors.
+ *	With NM_ListenServer the world listens with the game net driver, so replication paths that are skipped
+ *	in standalone, such as subobject registration and net conditions, are run as on a server.
+ */
+class FEquipmentTestWorld
+{
+public:
+	explicit FEquipmentTestWorld(ENetMode InNetMode = NM_Standalone);
+	~FEquipmentTestWorld();
+
+	FEquipmentTestWorld(const FEquipmentTestWorld&) = delete;
+	FEquipmentTestWorld& operator=(const FEquipmentTestWorld&) = delete;
+
+private:
+	UWorld* World{ nullptr };
+
+public:
+	UWorld* GetWorld() const { return World; }
+
+	/**
+	 * Advances the world by the number of frames
+	 */
+	void Tick(int32 NumFrames = 1, float DeltaSeconds = 1.0f / 60.0f);
+
+	/**
+	 * Spawns a pawn whose EquipmentManagerComponent is initialized with the EquipmentSet.
+	 * Returns nullptr if the component does not reach GameplayReady within MaxFrames.
+	 */
+	AEquipmentTestPawn* SpawnPawn(const UEquipmentSet* EquipmentSet, int32 MaxFrames = 30);
+
+public:
+	/**
+	 * Creates transient EquipmentData with the fragments, which must be outered to the returned object
+	 */
+	static UEquipmentData* CreateEquipmentData(TFunctionRef<void(UEquipmentData*)> AddFragments);
+	static UEquipmentData* CreateEquipmentData();
+
+	/**
+	 * Creates a transient EquipmentSet that adds the EquipmentData to each slot
+	 */
+	static UEquipmentSet* CreateEquipmentSet(const TArray<TPair<FGameplayTag, const UEquipmentData*>>& Entries, FGameplayTag DefaultActiveSlotTag = FGameplayTag::EmptyTag);
+
+};